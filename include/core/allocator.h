@@ -0,0 +1,106 @@
+#pragma once
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include "core/common.h"
+#include <infinirt.h>
+#include <mutex>
+
+namespace infini
+{
+    /**
+     * @brief Caching device allocator with power-of-two size-class bins.
+     * Freed blocks are kept per stream and reused by later requests. Large
+     * segments are split to serve smaller requests, and adjacent free blocks
+     * of the same segment are merged back when released. A block released
+     * on a stream other than the one it was allocated for is held back until
+     * an event recorded on the releasing stream completes.
+     */
+    class CachingAllocator
+    {
+    public:
+        static constexpr size_t kMinBlockSize = 512;        // rounding granularity
+        static constexpr size_t kSmallSize = 1 << 20;       // largest "small" request
+        static constexpr size_t kSmallBuffer = 2 << 20;     // segment for small requests
+        static constexpr size_t kLargeBuffer = 20 << 20;    // segment for medium requests
+        static constexpr size_t kMinLargeAlloc = 10 << 20;  // below this, use kLargeBuffer
+        static constexpr size_t kRoundLarge = 2 << 20;      // rounding for huge segments
+        static constexpr int kNumBins = 64;
+
+        struct BinStats
+        {
+            size_t hits = 0;   // served from cache
+            size_t misses = 0; // needed a new segment from the device
+        };
+
+    private:
+        struct Block
+        {
+            void *ptr;
+            size_t size;
+            infinirtStream_t stream;
+            bool allocated = false;
+            Block *prev = nullptr; // neighbours inside the same segment
+            Block *next = nullptr;
+        };
+
+        struct BlockComparator
+        {
+            bool operator()(const Block *a, const Block *b) const
+            {
+                if (a->stream != b->stream)
+                    return (uintptr_t)a->stream < (uintptr_t)b->stream;
+                if (a->size != b->size)
+                    return a->size < b->size;
+                return (uintptr_t)a->ptr < (uintptr_t)b->ptr;
+            }
+        };
+        using BlockSet = std::set<Block *, BlockComparator>;
+
+        mutable std::mutex mtx;
+        vector<BlockSet> bins;
+        vector<BinStats> stats;
+        std::unordered_map<void *, Block *> activeBlocks;
+        vector<pair<Block *, infinirtEvent_t>> pendingBlocks;
+        size_t allocatedBytes = 0;
+        size_t reservedBytes = 0;
+
+    public:
+        CachingAllocator();
+        CachingAllocator(const CachingAllocator &) = delete;
+        CachingAllocator &operator=(const CachingAllocator &) = delete;
+        // Cached segments are intentionally not released here: the device
+        // runtime may already be torn down during static destruction.
+        ~CachingAllocator() = default;
+
+        void *alloc(size_t size, infinirtStream_t stream = nullptr);
+        void free(void *ptr);
+        // Release once all work queued on `stream` so far has finished
+        void free(void *ptr, infinirtStream_t stream);
+        // Return every fully free segment to the device.
+        void emptyCache();
+
+        vector<BinStats> getStats() const;
+        size_t getAllocatedBytes() const;
+        size_t getReservedBytes() const;
+        size_t getPendingBlocks() const;
+        string toString() const;
+
+        static size_t roundSize(size_t size);
+        static int getBin(size_t size);
+
+    private:
+        static size_t getSegmentSize(size_t size);
+        static bool shouldSplit(const Block *block, size_t size);
+        Block *findFreeBlock(size_t size, infinirtStream_t stream);
+        Block *mallocSegment(size_t size, infinirtStream_t stream);
+        void releaseBlock(Block *block);
+        void processPendingBlocks(bool wait);
+        void insertFree(Block *block);
+        void eraseFree(Block *block);
+        void releaseCachedSegments();
+    };
+
+} // namespace infini
+
+#endif // ALLOCATOR_H
@@ -0,0 +1,94 @@
+#pragma once
+#ifndef ASYNC_RUN_H
+#define ASYNC_RUN_H
+
+#include "core/execution_plan.h"
+#include <infinirt.h>
+#include <mutex>
+
+namespace infini
+{
+    /**
+     * @brief Completion handle of one RuntimeObj::runAsync call. Graph
+     * outputs are copied into pinned staging buffers owned by the handle,
+     * so they stay valid however many runs are issued afterwards.
+     */
+    class RunFuture
+    {
+        friend class AsyncRunPool;
+
+    private:
+        Runtime runtime;
+        infinirtStream_t stream = nullptr;
+        Ref<void> event; // recorded after the output copies
+        std::unordered_map<TensorObj *, pair<void *, size_t>> outputs;
+
+    public:
+        RunFuture() = default;
+        RunFuture(RunFuture &&other) noexcept;
+        RunFuture &operator=(RunFuture &&other) noexcept;
+        RunFuture(const RunFuture &) = delete;
+        RunFuture &operator=(const RunFuture &) = delete;
+        ~RunFuture();
+
+        bool valid() const;
+        // Whether the run and its output copies have finished
+        bool ready() const;
+        void wait() const;
+        // Copy graph output `tensor` into host memory `dst`, waiting if needed
+        void getOutput(const Tensor &tensor, void *dst) const;
+
+    private:
+        void releaseOutputs();
+    };
+
+    /**
+     * @brief Buffers of the asynchronous runs of one prepared graph. Each of
+     * the fixed number of slots owns the activations of one in-flight run
+     * (its own arena, graph inputs and outputs) and launch records pointing
+     * at them; weights are shared. Slot 0 uses the graph's own buffers.
+     * A slot is reused once the run issued on it has completed.
+     */
+    class AsyncRunPool
+    {
+    private:
+        struct Slot
+        {
+            vector<LaunchRecord> records;
+            std::unordered_map<TensorObj *, void *> buffers; // per-slot storage
+            vector<Blob> blobs;
+            Ref<void> event; // completion of the latest run on the slot
+        };
+
+        Runtime runtime;
+        Ref<ExecutionPlan> plan;
+        std::set<TensorObj *> inputs;
+        TensorVec outputs;
+        vector<Slot> slots;
+        size_t next = 0;
+        std::mutex mtx;
+
+    public:
+        AsyncRunPool(const Graph &graph, Ref<ExecutionPlan> plan,
+                     const std::set<TensorObj *> &inputs, size_t numSlots);
+        ~AsyncRunPool();
+
+        // Issue one run on the current thread's stream
+        RunFuture run(const std::map<Tensor, const void *> &data);
+        // Whether the pool was built for `plan_` with these graph inputs
+        bool matches(const Ref<ExecutionPlan> &plan_,
+                     const std::map<Tensor, const void *> &data,
+                     size_t numSlots) const;
+        // Block until every issued run has completed
+        void drain();
+        size_t getNumSlots() const;
+        // Device pointer of `tensor` in slot `idx`
+        void *getBuffer(size_t idx, const Tensor &tensor) const;
+
+    private:
+        static Ref<void> recordEvent(infinirtStream_t stream);
+    };
+
+} // namespace infini
+
+#endif // ASYNC_RUN_H
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef AUTOTUNER_H
+#define AUTOTUNER_H
+
+#include "core/kernel.h"
+#include <atomic>
+#include <mutex>
+
+namespace infini
+{
+    /**
+     * @brief Chooses among the applicable kernel variants of an op.
+     * The first time a shape signature (device, op type, shapes, strides,
+     * dtypes and attributes) is seen, every candidate is timed and the
+     * fastest is remembered. Winners are written to a tuning cache file so
+     * later processes skip the timing; the file is taken from
+     * INFINI_TUNING_CACHE at startup or set with setCachePath. The choice is
+     * also kept on the op, so later lookups skip the signature until the
+     * op's shapes or the tuner's settings change.
+     */
+    class Autotuner
+    {
+    public:
+        static constexpr int kWarmup = 1;
+        static constexpr int kIterations = 5;
+
+    private:
+        mutable std::mutex mtx;
+        std::unordered_map<string, string> winners; // signature -> kernel name
+        string cachePath;
+        bool enabled = true;
+        size_t numTuned = 0;
+        std::atomic<size_t> numSelects = 0;
+        // Changes with the settings; choices kept on ops from another epoch
+        // are made again
+        std::atomic<size_t> epoch;
+
+    public:
+        Autotuner();
+        Autotuner(const Autotuner &) = delete;
+        Autotuner &operator=(const Autotuner &) = delete;
+
+        // Load the winners stored in `path` and save new ones there
+        void setCachePath(const string &path);
+        // When disabled, the highest ranked applicable variant is used
+        void setEnabled(bool enabled_);
+        bool isEnabled() const;
+
+        const Kernel *select(const Operator &op, const RuntimeObj *runtime);
+
+        // Signatures timed by this process
+        size_t getNumTuned() const;
+        // Calls to select, one per op dispatched without a prepared plan
+        size_t getNumSelects() const;
+        size_t size() const;
+        void clear();
+
+    private:
+        static string signature(infiniDevice_t device, const Operator &op);
+        const Kernel *choose(infiniDevice_t device, const Operator &op,
+                             const RuntimeObj *runtime);
+        void newEpoch();
+        const Kernel *tune(const string &sig, const Operator &op,
+                           const RuntimeObj *runtime,
+                           const vector<const KernelRegistry::KernelRecord *> &candidates);
+        void load(const string &path);
+        void save() const;
+    };
+
+} // namespace infini
+
+#endif // AUTOTUNER_H
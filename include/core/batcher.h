@@ -0,0 +1,90 @@
+#pragma once
+#ifndef BATCHER_H
+#define BATCHER_H
+
+#include "core/runtime.h"
+#include "utils/histogram.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+
+namespace infini
+{
+    /**
+     * @brief Front-end coalescing single-item requests into batched runs of
+     * one graph. The first dimension of every listed input and output is the
+     * batch dimension. A worker thread with its own context waits until
+     * maxBatchSize requests are queued or the oldest one has waited maxWait,
+     * stacks their inputs, switches the graph to that batch size (prepared
+     * shapes are cached by the graph) and scatters the output rows back.
+     */
+    class DynamicBatcher
+    {
+    public:
+        struct Config
+        {
+            size_t maxBatchSize = 8;
+            std::chrono::microseconds maxWait{1000};
+        };
+
+        // Output tensor -> bytes of the request's row
+        using Result = std::map<Tensor, vector<uint8_t>>;
+
+        struct Stats
+        {
+            Histogram queueDelayUs = Histogram::exponential(1 << 20);
+            Histogram batchSize = Histogram::linear(1);
+            size_t requests = 0;
+            size_t batches = 0;
+            string toString() const;
+        };
+
+    private:
+        struct Request
+        {
+            vector<vector<uint8_t>> inputs; // same order as `inputs`
+            std::promise<Result> promise;
+            bool fulfilled = false; // promise already holds a value
+            std::chrono::steady_clock::time_point enqueued;
+        };
+
+        Runtime runtime;
+        Graph graph;
+        TensorVec inputs, outputs;
+        Config config;
+        vector<size_t> inputRowBytes;
+
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<Request> queue;
+        bool stopping = false;
+        Stats stats;
+        std::thread worker;
+
+    public:
+        /**
+         * @param inputs Graph inputs fed by requests, one row each.
+         * @param outputs Tensors whose rows are returned to the requests.
+         * The graph must not be allocated yet; it is allocated and prepared
+         * on the worker thread.
+         */
+        DynamicBatcher(Runtime runtime, Graph graph, TensorVec inputs,
+                       TensorVec outputs, Config config);
+        DynamicBatcher(const DynamicBatcher &) = delete;
+        DynamicBatcher &operator=(const DynamicBatcher &) = delete;
+        // Serves the queued requests before returning
+        ~DynamicBatcher();
+
+        // `data` holds one row of every input, copied before returning
+        std::future<Result> submit(const vector<const void *> &data);
+        Stats getStats();
+
+    private:
+        void workerLoop();
+        void runBatch(vector<Request> &batch);
+    };
+
+} // namespace infini
+
+#endif // BATCHER_H
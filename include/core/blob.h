@@ -3,22 +3,53 @@
 #define BLOB_H
 
 #include "core/ref.h"
+#include <infinirt.h>
 
 namespace infini
 {
 
+  // Where the memory behind a blob lives
+  enum class MemoryLocation
+  {
+    Device,
+    Host,
+  };
+
   class BlobObj
   {
     void *ptr;
+    MemoryLocation location = MemoryLocation::Device;
+    // Allocator handle: a blob holding a runtime owns its pointer and hands
+    // it back with RuntimeObj::freeAsync on `stream` when destroyed.
+    Runtime runtime = nullptr;
+    infinirtStream_t stream = nullptr;
+    // Keeps the memory behind a borrowed pointer alive, e.g. the blob a
+    // sub-buffer was carved from or a memory-mapped file
+    Ref<void> holder = nullptr;
 
   public:
-    BlobObj(void *ptr) : ptr(ptr) {}
+    BlobObj(void *ptr, MemoryLocation location = MemoryLocation::Device)
+        : ptr(ptr), location(location) {}
+    BlobObj(Runtime runtime, void *ptr, infinirtStream_t stream = nullptr)
+        : ptr(ptr), runtime(std::move(runtime)), stream(stream) {}
+    BlobObj(Blob base, size_t offset)
+        : ptr(base->getPtr<char *>() + offset), location(base->location),
+          holder(std::move(base)) {}
+    BlobObj(void *ptr, Ref<void> holder, MemoryLocation location)
+        : ptr(ptr), location(location), holder(std::move(holder)) {}
     BlobObj(BlobObj &other) = delete;
     BlobObj &operator=(BlobObj const &) = delete;
-    ~BlobObj(){};
+    ~BlobObj();
 
     template <typename T>
     T getPtr() const { return reinterpret_cast<T>(ptr); }
+
+    bool isOwner() const { return runtime != nullptr; }
+    // Memory provided by the caller, neither owned nor kept alive by us
+    bool isExternal() const { return runtime == nullptr && holder == nullptr; }
+    MemoryLocation getLocation() const { return location; }
+    // Order the release after work queued on `stream_` instead
+    void recordStream(infinirtStream_t stream_) { stream = stream_; }
   };
 
 } // namespace infini
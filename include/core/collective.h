@@ -0,0 +1,73 @@
+#pragma once
+#ifndef COLLECTIVE_H
+#define COLLECTIVE_H
+
+#include "core/tensor.h"
+#include <condition_variable>
+#include <infinirt.h>
+#include <mutex>
+
+namespace infini
+{
+    /**
+     * @brief One rank's endpoint of a communication group. Collectives are
+     * ordered after the work queued on `stream` and must be called by every
+     * rank of the group in the same order.
+     */
+    class Communicator
+    {
+    public:
+        virtual ~Communicator() = default;
+
+        virtual int getRank() const = 0;
+        virtual int getWorldSize() const = 0;
+        // Element-wise sum of `count` elements across ranks, in place
+        virtual void allReduceSum(void *data, size_t count, DataType dtype,
+                                  infinirtStream_t stream) = 0;
+        // Concatenate `bytes` bytes of every rank into `recv` in rank order
+        virtual void allGather(const void *send, void *recv, size_t bytes,
+                               infinirtStream_t stream) = 0;
+    };
+
+    /**
+     * @brief In-process stand-in for a collective library: ranks are threads
+     * of one process exchanging host-accessible buffers through shared
+     * memory. Calls block until every rank has joined.
+     */
+    class SharedMemoryCommunicator : public Communicator
+    {
+    private:
+        struct Group
+        {
+            int worldSize;
+            std::mutex mtx;
+            std::condition_variable cv;
+            int arrived = 0;
+            uint64_t generation = 0;
+            vector<const void *> buffers;
+
+            explicit Group(int worldSize)
+                : worldSize(worldSize), buffers(worldSize, nullptr) {}
+            void barrier();
+        };
+
+        Ref<Group> group;
+        int rank;
+
+        SharedMemoryCommunicator(Ref<Group> group, int rank);
+
+    public:
+        // Endpoints of a new group, indexed by rank
+        static vector<Ref<Communicator>> createGroup(int worldSize);
+
+        int getRank() const override;
+        int getWorldSize() const override;
+        void allReduceSum(void *data, size_t count, DataType dtype,
+                          infinirtStream_t stream) override;
+        void allGather(const void *send, void *recv, size_t bytes,
+                       infinirtStream_t stream) override;
+    };
+
+} // namespace infini
+
+#endif // COLLECTIVE_H
@@ -0,0 +1,83 @@
+#pragma once
+#ifndef DESCRIPTOR_CACHE_H
+#define DESCRIPTOR_CACHE_H
+
+#include "core/op_type.h"
+#include "core/tensor.h"
+#include <functional>
+#include <list>
+
+namespace infini
+{
+    /**
+     * @brief Byte string identifying an infiniop descriptor: the op type, the
+     * shape, stride and dtype of every tensor and the attributes baked into
+     * the descriptor. Data pointers and per-call scalars are not part of it.
+     */
+    class DescriptorKey
+    {
+    private:
+        string bytes;
+
+    public:
+        explicit DescriptorKey(OpType type);
+        DescriptorKey &add(const Tensor &tensor);
+
+        template <typename T>
+        DescriptorKey &add(const T &attr)
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "Descriptor attributes must be trivially copyable");
+            bytes.append(reinterpret_cast<const char *>(&attr), sizeof(T));
+            return *this;
+        }
+
+        const string &str() const;
+    };
+
+    /**
+     * @brief Descriptors created with one context's handle, shared by every
+     * op with the same key. At most `capacity` descriptors are kept; the
+     * least recently used one is dropped first. A dropped descriptor is
+     * destroyed once no op refers to it any more.
+     */
+    class DescriptorCache
+    {
+    public:
+        static constexpr size_t kDefaultCapacity = 1024;
+
+    private:
+        using Entry = pair<string, Ref<void>>;
+        // Most recently used first
+        std::list<Entry> lru;
+        std::unordered_map<string, std::list<Entry>::iterator> entries;
+        size_t capacity = kDefaultCapacity;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+
+    public:
+        DescriptorCache() = default;
+        DescriptorCache(const DescriptorCache &) = delete;
+        DescriptorCache &operator=(const DescriptorCache &) = delete;
+
+        Ref<void> getOrCreate(const DescriptorKey &key,
+                              const std::function<Ref<void>()> &create);
+        void clear();
+        // Evicts least recently used descriptors beyond the new capacity
+        void setCapacity(size_t capacity_);
+        size_t getCapacity() const;
+
+        size_t size() const;
+        size_t getHits() const;
+        // Number of descriptors created
+        size_t getMisses() const;
+        size_t getEvictions() const;
+
+    private:
+        void evict();
+    };
+
+} // namespace infini
+
+#endif // DESCRIPTOR_CACHE_H
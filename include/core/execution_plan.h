@@ -0,0 +1,33 @@
+#pragma once
+#ifndef EXECUTION_PLAN_H
+#define EXECUTION_PLAN_H
+
+#include "core/kernel.h"
+
+namespace infini
+{
+    /**
+     * @brief Launch records of a graph in execution order, built by
+     * RuntimeObj::prepare for one thread context. Shape changes and graph
+     * rewrites drop the plan; tensors rebound to other storage (bindExternal,
+     * attachBlob, dataMalloc) are picked up by refreshStaleData.
+     */
+    struct ExecutionPlan
+    {
+        vector<LaunchRecord> records;
+        size_t workspaceSize = 0;
+        infiniopHandle_t handle = nullptr; // context the plan was prepared for
+        // Data pointers move between runs (host offload) and are re-read
+        // before every launch
+        bool refreshData = false;
+
+        static void fillData(LaunchRecord &record);
+        // Whether a tensor of `record` no longer uses the recorded blob
+        static bool isStale(const LaunchRecord &record);
+        // Re-read the data of stale records; return whether any was stale
+        bool refreshStaleData();
+    };
+
+} // namespace infini
+
+#endif // EXECUTION_PLAN_H
@@ -2,18 +2,38 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include "core/execution_plan.h"
+#include "core/memory_planner.h"
+#include "core/offload.h"
 #include "core/operator.h"
+#include "core/pass_manager.h"
+#include "core/plan_cache.h"
 #include <algorithm>
 #include <numeric>
 
 namespace infini
 {
+    class AsyncRunPool;
+
     class GraphObj : public Object
     {
+        friend class GraphSerializer;
+
     protected:
         Runtime runtime;
         TensorVec tensors;
         OpVec ops;
+        TensorVec outputs; // declared by the user, empty if unknown
+        MemoryPlan memoryPlan;
+        Blob arena = nullptr;
+        optional<size_t> workspaceSize;
+        Ref<OffloadManager> offloader;
+        Ref<ExecutionPlan> plan;
+        Ref<AsyncRunPool> asyncPool;
+        std::unordered_map<OperatorObj *, int> streamAssignment;
+        PlanCache planCache;
+        OptLevel optLevel = OptLevel::O0;
+        PassReport passReport;
 
     public:
         explicit GraphObj(Runtime runtime);
@@ -23,16 +43,67 @@ namespace infini
         Tensor addTensor(Shape dim, DataType dtype);
         Tensor addTensor(const Tensor &tensor);
         TensorVec addTensor(const TensorVec &tensors);
+        // Remove `op` and its edges; its outputs are left without a source
         void removeOperator(Operator op);
         void removeTensor(Tensor tensor);
+        // Make every op reading `from` read `to` instead
+        void replaceAllUses(const Tensor &from, const Tensor &to);
+        /**
+         * @brief Declare the tensors callers read after a run. Rewrites keep
+         * them and may drop anything they do not depend on.
+         */
+        void setOutputs(TensorVec outputs_);
+        const TensorVec &getOutputs() const;
+        bool isOutput(const Tensor &tensor) const;
         const TensorVec &getTensors() const;
         const OpVec &getOperators() const;
         Tensor getTensor(int) const;
         bool topo_sort();
 
         void shape_infer();
+        /**
+         * @brief Re-infer only the ops downstream of the tensors in `changed`.
+         * Ops must be topologically sorted.
+         * @return Number of ops whose shapes were inferred again.
+         */
+        size_t shape_infer(const TensorVec &changed);
+        /**
+         * @brief Give graph inputs new shapes. Everything prepared for the
+         * previous shapes is kept in a cache keyed by the input shapes, so
+         * switching back to them restores it instead of re-planning. On a
+         * miss, shapes are re-inferred incrementally and, if the graph was
+         * allocated, activations get new storage; prepare must be called
+         * again before running.
+         */
+        void setInputShapes(const std::map<Tensor, Shape> &shapes);
+        PlanCache &getPlanCache();
 
+        /**
+         * @brief Allocate memory for all tensors. Intermediate tensors are
+         * packed into one arena according to their live ranges over the
+         * topologically sorted ops; other tensors get their own buffers.
+         * Tensors that already have storage are left untouched.
+         * With a runtime memory budget, tensors outside the arena are kept in
+         * pinned host memory and moved to the device on demand while running.
+         */
         void dataMalloc();
+        const MemoryPlan &getMemoryPlan() const;
+        // Host offloading state, null when the runtime has no memory budget
+        Ref<OffloadManager> getOffloader() const;
+        // Plan set by RuntimeObj::prepare, dropped when the graph changes
+        Ref<ExecutionPlan> getPlan() const;
+        void setPlan(Ref<ExecutionPlan> plan_);
+        // Per-run buffers of RuntimeObj::runAsync, rebuilt when the plan changes
+        Ref<AsyncRunPool> getAsyncPool() const;
+        void setAsyncPool(Ref<AsyncRunPool> pool);
+        /**
+         * @brief Streams the ops will run on, taken into account by the next
+         * dataMalloc so that concurrently running ops never share memory.
+         */
+        void setStreamAssignment(std::unordered_map<OperatorObj *, int> assignment);
+        const std::unordered_map<OperatorObj *, int> &getStreamAssignment() const;
+        // Largest workspace required by any op, computed lazily
+        size_t getWorkspaceSize();
 
         template <typename T, typename... Args>
         Ref<T> addOp(Args &&...args)
@@ -50,10 +121,37 @@ namespace infini
             return op;
         }
 
+        // Insert an op built without a graph, e.g. by OperatorObj::clone
+        void addOperator(const Operator &op);
+        /**
+         * @brief New graph running `ops`, a subset of this graph's ops in
+         * execution order. Tensors are copied without storage, except weights
+         * (no source op, data present), which share their storage.
+         * @param tensorMap Receives the copy of every tensor used by `ops`.
+         */
+        Graph extractSubgraph(const OpVec &ops,
+                              std::unordered_map<TensorObj *, Tensor> &tensorMap) const;
+
         bool checkValid() const;
 
+        /**
+         * @brief Rewrite the graph with `passes`. If the graph was already
+         * allocated, tensors created by the passes get storage afterwards.
+         */
+        const PassReport &optimize(const PassManager &passes);
+        // Run the passes of `level` unless the graph was optimized at least as much
+        void optimize(OptLevel level);
+        OptLevel getOptLevel() const;
+        // Report of the latest optimize
+        const PassReport &getPassReport() const;
+
     private:
         void addOperatorAndConnect(const Operator &op);
+        // Tensors not produced by any op: graph inputs and weights
+        TensorVec getSourceTensors() const;
+        PreparedShape capturePrepared() const;
+        // Rebind activations and the `resized` inputs to their cached storage
+        void restorePrepared(const PreparedShape &prepared, const TensorVec &resized);
     };
 
 } // namespace infini
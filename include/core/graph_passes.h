@@ -0,0 +1,80 @@
+#pragma once
+#ifndef GRAPH_PASSES_H
+#define GRAPH_PASSES_H
+
+#include "core/pass_manager.h"
+
+namespace infini
+{
+    // Drop tensors that are neither produced nor read by any op
+    class PruneDanglingTensorsPass : public GraphPass
+    {
+    public:
+        string getName() const override { return "prune-dangling-tensors"; }
+        bool run(GraphObj &graph) override;
+    };
+
+    /**
+     * @brief Remove every op and tensor the declared graph outputs do not
+     * depend on. Does nothing for graphs without declared outputs.
+     */
+    class EliminateDeadCodePass : public GraphPass
+    {
+    public:
+        string getName() const override { return "eliminate-dead-code"; }
+        bool run(GraphObj &graph) override;
+    };
+
+    /**
+     * @brief Merge ops of the same type reading the same tensors with equal
+     * attributes (OperatorObj::addAttrs); readers of the duplicate's outputs
+     * are moved to the first op's outputs. Ops writing declared graph
+     * outputs are kept.
+     */
+    class EliminateCommonSubexpressionsPass : public GraphPass
+    {
+    public:
+        string getName() const override { return "eliminate-common-subexpressions"; }
+        bool run(GraphObj &graph) override;
+    };
+
+    /**
+     * @brief Let Gemms read the input of a Transpose swapping the last two
+     * dims directly, flipping transA/transB so the transposition is done
+     * through descriptor strides instead of a copy. The Transpose is removed
+     * once nothing else reads its output.
+     */
+    class AbsorbTransposePass : public GraphPass
+    {
+    public:
+        string getName() const override { return "absorb-transpose"; }
+        bool run(GraphObj &graph) override;
+    };
+
+    // Fold a Relu or Clip that is the only reader of a Gemm's output into
+    // the Gemm. This saves the intermediate tensor and a launch record; the
+    // infiniop kernel still runs the activation as its own pass over Y.
+    class FuseGemmActivationPass : public GraphPass
+    {
+    public:
+        string getName() const override { return "fuse-gemm-activation"; }
+        bool run(GraphObj &graph) override;
+    };
+
+    /**
+     * @brief Evaluate ops reading only weights once, with the registered
+     * kernels, and turn their outputs into weights. Weights left without
+     * readers are dropped from the graph along with their storage. Ops whose
+     * outputs depend on more than their inputs and attributes, such as a
+     * Gemm scaling the previous Y by beta, are left alone.
+     */
+    class FoldConstantsPass : public GraphPass
+    {
+    public:
+        string getName() const override { return "fold-constants"; }
+        bool run(GraphObj &graph) override;
+    };
+
+} // namespace infini
+
+#endif // GRAPH_PASSES_H
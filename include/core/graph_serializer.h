@@ -0,0 +1,52 @@
+#pragma once
+#ifndef GRAPH_SERIALIZER_H
+#define GRAPH_SERIALIZER_H
+
+#include "core/graph.h"
+
+namespace infini
+{
+    /**
+     * @brief Compact, versioned binary format for GraphObj.
+     *
+     * Layout (host endianness):
+     *   header   : magic "ITGRAPH\0", u32 version, u32 flags, u64 #tensors,
+     *              u64 #ops, u64 data section offset
+     *   tensors  : i32 fuid, i32 dtype, u32 rank, u64 shape[rank],
+     *              i64 stride[rank], u64 data offset, u64 data bytes
+     *   ops      : u16 type, u32 #inputs, u32 #outputs, i32 fuids...,
+     *              u32 attribute bytes, attributes
+     *   data     : inline weights, each aligned to kDataAlignment
+     *
+     * Loading maps the file and rebuilds the graph directly from the records
+     * without shape inference or validation. Loaded tensors get fresh fuids;
+     * the stored fuids only describe the topology.
+     */
+    class GraphSerializer
+    {
+    public:
+        static constexpr char kMagic[8] = {'I', 'T', 'G', 'R', 'A', 'P', 'H', '\0'};
+        static constexpr uint32_t kVersion = 2; // 2: Gemm bias and activation
+        static constexpr uint32_t kMinVersion = 1; // oldest version still loaded
+        static constexpr size_t kDataAlignment = 64;
+        static constexpr uint64_t kNoData = ~uint64_t(0);
+
+        /**
+         * @brief Write `graph` to `path`.
+         * @param withWeights Store the data of tensors without a source op
+         * (weights and inputs) inline.
+         */
+        static void save(const Graph &graph, const string &path, bool withWeights = true);
+        static Graph load(const Runtime &runtime, const string &path);
+
+    private:
+        static void writeAttributes(const Operator &op, std::ostream &os);
+        // `version` is the file version the attributes were written with
+        static Operator createOperator(uint32_t version, OpType type,
+                                       const TensorVec &inputs, const TensorVec &outputs,
+                                       const char *attrs, size_t attrBytes);
+    };
+
+} // namespace infini
+
+#endif // GRAPH_SERIALIZER_H
@@ -1,54 +1,107 @@
 #pragma once
 #include "core/operator.h"
+#include <algorithm>
 #include <infinirt.h>
 namespace infini
 {
     class RuntimeObj;
+    class Kernel;
     using KernelAttrs = std::tuple<infiniDevice_t, OpType::underlying_t>;
+
+    /**
+     * @brief Everything needed to launch one op, resolved ahead of time by
+     * RuntimeObj::prepare. Data pointers are stored outputs first, then
+     * inputs, following the argument order of infiniop. `blobs` keeps the
+     * storage behind them alive and tells when a tensor has been rebound.
+     */
+    struct LaunchRecord
+    {
+        static constexpr size_t kMaxArgs = 8;
+
+        const Kernel *kernel = nullptr;
+        Operator op;
+        void *desc = nullptr;
+        size_t workspaceSize = 0;
+        uint32_t numOutputs = 0;
+        uint32_t numInputs = 0;
+        void *data[kMaxArgs] = {};
+        Blob blobs[kMaxArgs];
+
+        void *output(size_t idx) const { return data[idx]; }
+        void *input(size_t idx) const { return data[numOutputs + idx]; }
+    };
+
     class Kernel
     {
     public:
         Kernel() {}
         virtual ~Kernel() {}
         virtual void compute(const Operator &op, const RuntimeObj *context) const = 0;
+        // Whether the kernel supports the shapes, strides and dtypes of `op`
+        virtual bool isApplicable(const Operator &op) const { return true; }
+        /**
+         * @brief Replay a prepared launch. Kernels override this to skip the
+         * per-call lookups of compute; the default simply calls compute.
+         */
+        virtual void launch(const LaunchRecord &record, void *workspace,
+                            infinirtStream_t stream, const RuntimeObj *context) const;
     };
 
+    /**
+     * @brief Kernels by (device, OpType). A key may have several variants,
+     * kept in descending rank order; the autotuner picks among the ones
+     * applicable to an op, otherwise the highest ranked applicable one wins.
+     */
     class KernelRegistry
     {
     public:
-        using KernelRecord = tuple<Kernel *const, const string, const int>; // Kernel, name, ID
+        using KernelRecord = tuple<Kernel *const, const string, const int, const int>; // Kernel, name, ID, rank
 
     private:
-        std::map<KernelAttrs, KernelRecord> kernels;
+        std::map<KernelAttrs, list<KernelRecord>> kernels;
         int nKernels = 0;
 
     public:
         ~KernelRegistry()
         {
-            for (auto &[k, v] : kernels)
-                delete std::get<0>(v);
+            for (auto &[k, records] : kernels)
+                for (auto &record : records)
+                    delete std::get<0>(record);
         }
         static KernelRegistry &getInstance()
         {
             static KernelRegistry instance;
             return instance;
         }
-        bool registerKernel(const KernelAttrs &key, Kernel *kernel, string name)
+        bool registerKernel(const KernelAttrs &key, Kernel *kernel, string name,
+                            int rank = 0)
         {
-            IT_ASSERT(kernels.find(key) == kernels.end(),
-                      "Kernel already registered");
-            kernels.emplace(key, KernelRecord{kernel, name, ++nKernels});
+            auto &records = kernels[key];
+            for (auto &record : records)
+                IT_ASSERT(std::get<1>(record) != name, "Kernel already registered");
+            auto it = std::find_if(records.begin(), records.end(),
+                                   [rank](const KernelRecord &record)
+                                   { return std::get<3>(record) < rank; });
+            records.emplace(it, KernelRecord{kernel, name, ++nKernels, rank});
             return true;
         }
+        // Highest ranked variant
         Kernel *getKernel(const KernelAttrs &kernelAttrs) const
         {
-            auto it = kernels.find(kernelAttrs);
-            IT_ASSERT(it != kernels.end(), "Kernel not found");
-            return std::get<0>(it->second);
+            return std::get<0>(getKernelItem(kernelAttrs));
         }
         const KernelRecord &getKernelItem(const KernelAttrs &kernelAttrs) const
         {
-            return kernels.at(kernelAttrs);
+            auto it = kernels.find(kernelAttrs);
+            IT_ASSERT(it != kernels.end() && !it->second.empty(), "Kernel not found");
+            return it->second.front();
+        }
+        // All variants, highest rank first
+        const list<KernelRecord> &getKernelItems(const KernelAttrs &kernelAttrs) const
+        {
+            auto it = kernels.find(kernelAttrs);
+            IT_ASSERT(it != kernels.end() && !it->second.empty(), "Kernel not found");
+            return it->second;
         }
     };
 
@@ -66,6 +119,20 @@ namespace infini
 #define REGISTER_KERNEL(device, opType, kernel, name) \
     _REGISTER_KERNEL_1(device, opType, kernel, name, __COUNTER__)
 
+#define _REGISTER_KERNEL_VARIANT_1(device, opType, kernel, name, rank, cnt)    \
+    namespace infini                                                          \
+    {                                                                         \
+        static const bool _CAT(_register_kernel_, cnt) =                      \
+            KernelRegistry::getInstance().registerKernel(KernelAttrs{device,  \
+                                                                     opType}, \
+                                                         new kernel(), name,  \
+                                                         rank);               \
+    }
+
+// Additional variant for a key; higher ranks are preferred without tuning
+#define REGISTER_KERNEL_VARIANT(device, opType, kernel, name, rank) \
+    _REGISTER_KERNEL_VARIANT_1(device, opType, kernel, name, rank, __COUNTER__)
+
 #define REGISTER_KERNEL_ALL_DEVICES(opType, kernel)                                                               \
     REGISTER_KERNEL(infiniDevice_t::INFINI_DEVICE_NVIDIA, opType, kernel, TOSTRING(_CAT(kernel, _NVIDIA)));       \
     REGISTER_KERNEL(infiniDevice_t::INFINI_DEVICE_CPU, opType, kernel, TOSTRING(_CAT(kernel, _CPU)));             \
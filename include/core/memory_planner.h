@@ -0,0 +1,80 @@
+#pragma once
+#ifndef MEMORY_PLANNER_H
+#define MEMORY_PLANNER_H
+
+#include "core/operator.h"
+
+namespace infini
+{
+    /**
+     * @brief Result of static memory planning for one graph.
+     * Intermediate tensors are packed into a single arena at fixed offsets,
+     * everything else (weights, graph inputs and outputs) stays pinned in its
+     * own allocation. Tensors that already have storage are skipped.
+     */
+    struct MemoryPlan
+    {
+        size_t arenaSize = 0;  // planned peak of the activation arena
+        size_t naiveSize = 0;  // sum of planned tensors if allocated separately
+        size_t pinnedSize = 0; // bytes kept outside the arena
+        size_t inplaceCount = 0; // outputs aliasing one of their op's inputs
+        std::unordered_map<TensorObj *, size_t> offsets;
+
+        bool isPlanned(const Tensor &tensor) const;
+        size_t getOffset(const Tensor &tensor) const;
+        string toString() const;
+    };
+
+    class MemoryPlanner
+    {
+    public:
+        static constexpr size_t alignment = 256;
+
+    private:
+        // A buffer in the arena, shared by tensors executed in place
+        struct LiveRange
+        {
+            TensorVec tensors;
+            size_t size;
+            size_t begin; // index of the producing op of the first tensor
+            size_t end;   // index of the last consuming op of the last tensor
+            vector<size_t> readers; // indices of all consuming ops
+        };
+
+        // happensBefore[i] has bit j set if op i completes before op j starts
+        using Reachability = vector<vector<uint64_t>>;
+
+    public:
+        /**
+         * @brief Plan the activation arena for a topologically sorted op list.
+         * @param ops Operators in execution order.
+         * @param tensors All tensors of the graph.
+         * @param streamOf Stream of every op when ops run on several streams.
+         * Buffers are then only shared, in place or not, if every reader of
+         * one is ordered, through data edges or stream order, before the
+         * producer of the other.
+         * @param outputs Declared graph outputs; they stay pinned even when
+         * other ops read them.
+         */
+        static MemoryPlan plan(const OpVec &ops, const TensorVec &tensors,
+                               const vector<int> &streamOf = {},
+                               const TensorVec &outputs = {});
+        static size_t alignSize(size_t size);
+
+    private:
+        static vector<LiveRange> computeLiveRanges(const OpVec &ops,
+                                                   const TensorVec &tensors,
+                                                   const TensorVec &outputs,
+                                                   MemoryPlan &plan);
+        // Let outputs reuse the buffer of an input whose life ends at the op.
+        // With `reach`, every other reader of the input must also complete
+        // before the op starts.
+        static void mergeInplace(const OpVec &ops, const Reachability &reach,
+                                 vector<LiveRange> &ranges, MemoryPlan &plan);
+        static Reachability computeReachability(const OpVec &ops,
+                                                const vector<int> &streamOf);
+    };
+
+} // namespace infini
+
+#endif // MEMORY_PLANNER_H
@@ -0,0 +1,83 @@
+#pragma once
+#ifndef OFFLOAD_H
+#define OFFLOAD_H
+
+#include "core/operator.h"
+#include <infinirt.h>
+
+namespace infini
+{
+    /**
+     * @brief Keeps the device footprint of a graph under a memory budget.
+     * Tensors outside the activation arena live in pinned host memory and
+     * are brought to the device on demand. While op i runs, the tensors of
+     * op i+1 are prefetched on a separate copy stream; when space is needed
+     * the resident tensor whose next use is farthest away is evicted. Weights
+     * keep a valid host copy and are simply dropped unless they were updated
+     * from host while resident; other tensors are copied back before
+     * eviction.
+     */
+    class OffloadManager
+    {
+    public:
+        struct Stats
+        {
+            size_t h2dBytes = 0;
+            size_t d2hBytes = 0;
+            size_t prefetches = 0; // uploads issued one op ahead
+            size_t evictions = 0;
+            size_t peakDeviceBytes = 0; // arena plus resident tensors
+            string toString() const;
+        };
+
+    private:
+        struct Entry
+        {
+            Tensor tensor;
+            size_t bytes;
+            Blob host;
+            Blob device = nullptr;
+            infinirtEvent_t ready = nullptr; // upload completion
+            size_t hostWrites = 0;           // tensor writes the host copy holds
+            vector<size_t> uses;             // indices of ops using the tensor
+        };
+
+        Runtime runtime;
+        size_t budget;
+        size_t fixedBytes; // device memory that is always resident
+        size_t residentBytes = 0;
+        vector<Entry> entries;
+        vector<vector<size_t>> opEntries;
+        infinirtStream_t copyStream = nullptr;
+        Stats stats;
+
+    public:
+        /**
+         * @param budget Device bytes available to the graph.
+         * @param fixedBytes Device bytes the graph holds permanently.
+         * @param managed Tensors to place in host memory and offload; they
+         * must not have storage yet.
+         */
+        OffloadManager(Runtime runtime, size_t budget, size_t fixedBytes,
+                       const OpVec &ops, const TensorVec &managed);
+        OffloadManager(const OffloadManager &) = delete;
+        OffloadManager &operator=(const OffloadManager &) = delete;
+        ~OffloadManager();
+
+        void beginRun();
+        // Make op `idx` runnable on `stream` and prefetch for the next op
+        void beforeOp(size_t idx, infinirtStream_t stream);
+        // Statistics of the latest run
+        const Stats &getStats() const;
+
+    private:
+        bool isResident(const Entry &entry) const;
+        size_t nextUse(const Entry &entry, size_t idx) const;
+        bool makeRoom(size_t bytes, size_t idx, infinirtStream_t stream);
+        bool upload(size_t entryIdx, size_t idx, infinirtStream_t stream);
+        void evict(Entry &entry, infinirtStream_t stream);
+    };
+
+} // namespace infini
+
+#endif // OFFLOAD_H
@@ -23,7 +23,10 @@ namespace infini
             Relu,
             Sub,
             Transpose,
-            RMSNorm
+            RMSNorm,
+            AllReduceSum,
+            AllGather,
+            Split
         } type;
 
         constexpr OpType(decltype(type) t) : type(t) {}
@@ -52,6 +55,11 @@ namespace infini
                 CASE(Transpose);
                 CASE(Concat);
                 CASE(MatMul);
+                CASE(Gemm);
+                CASE(RMSNorm);
+                CASE(AllReduceSum);
+                CASE(AllGather);
+                CASE(Split);
 
             default:
                 return "Unknown";
@@ -2,15 +2,28 @@
 #ifndef OPERATOR_H
 #define OPERATOR_H
 
+#include "core/descriptor_cache.h"
 #include "core/op_type.h"
 #include "core/tensor.h"
+#include <infiniop/handle.h>
 
 namespace infini
 {
+    class Kernel;
+
+    /**
+     * @brief Tag selecting operator constructors that trust their arguments
+     * (e.g. when loading a serialized graph): outputs are given and no shape
+     * inference or validation is performed.
+     */
+    struct Unchecked
+    {
+    };
 
     class OperatorObj : public Object
     {
         friend class GraphObj;
+        friend class Autotuner;
 
     protected:
         OpType type;
@@ -19,6 +32,15 @@ namespace infini
         vector<WRef<OperatorObj>> predecessors;
         vector<WRef<OperatorObj>> successors;
         void *infiniOpDesc = nullptr;
+        // Keeps infiniOpDesc alive; shared with the context's descriptor cache
+        Ref<void> opDesc;
+        string descKey;
+        infiniopHandle_t descHandle = nullptr;
+        // Kernel chosen by the autotuner for `kernelDevice`, kept until the
+        // op's shapes change or the autotuner's settings do
+        const Kernel *kernel = nullptr;
+        infiniDevice_t kernelDevice = INFINI_DEVICE_CPU;
+        size_t kernelEpoch = 0;
 
     public:
         OperatorObj(OpType opType, TensorVec inputs, TensorVec outputs);
@@ -33,13 +55,39 @@ namespace infini
         DataType getOutDType(size_t idx) const;
         ElementType getNumInputs() const;
         ElementType getNumOutputs() const;
-        virtual void createOpDesc() = 0;
+        /**
+         * @brief Create the op's infiniop descriptor with `handle`. The
+         * returned reference destroys the descriptor when released.
+         */
+        virtual Ref<void> createOpDesc(infiniopHandle_t handle) = 0;
+        // Scratch bytes required by the op's kernel, 0 if none
+        virtual size_t getWorkspaceSize(const RuntimeObj *runtime);
+        // (input index, output index) pairs that may share one buffer
+        virtual vector<pair<int, int>> getInplacePairs() const;
         void *getInfiniOpDesc() const;
+        // Descriptor for the current context, created only on a cache miss
+        void *getInfiniOpDesc(const RuntimeObj *runtime);
+        void resetOpDesc();
+        DescriptorKey getDescKey() const;
+        /**
+         * @brief Same op reading `inputs` and writing `outputs`, which must
+         * have the shapes the op infers. Used to copy ops into other graphs.
+         */
+        virtual Operator clone(const TensorVec &inputs, const TensorVec &outputs) const;
+        /**
+         * @brief Append every attribute the outputs depend on, so that ops of
+         * one type reading the same tensors with equal attributes compute the
+         * same outputs. Return false if the op must never be merged with
+         * another, the default.
+         */
+        virtual bool addAttrs(DescriptorKey &key) const;
 
     protected:
         virtual optional<vector<Shape>> inferShape() = 0;
         virtual vector<DataType> inferDataType() const = 0;
         bool checkValid(GraphObj *graph);
+        // Attributes baked into the descriptor, appended to the cache key
+        virtual void addDescAttrs(DescriptorKey &key) const;
 
     private:
         void addPredecessors(const Operator &op);
@@ -0,0 +1,83 @@
+#pragma once
+#ifndef PASS_MANAGER_H
+#define PASS_MANAGER_H
+
+#include "core/common.h"
+#include "core/ref.h"
+
+namespace infini
+{
+    /**
+     * @brief How much work RuntimeObj::prepare spends rewriting a graph.
+     * O0 runs the graph as built; each higher level adds passes to the
+     * previous one, so add a level only together with the passes it adds.
+     */
+    enum class OptLevel
+    {
+        O0,
+        O1,
+    };
+
+    // A rewrite of a graph in place
+    class GraphPass
+    {
+    public:
+        virtual ~GraphPass() = default;
+        virtual string getName() const = 0;
+        // Return whether the graph was changed
+        virtual bool run(GraphObj &graph) = 0;
+    };
+
+    struct PassStats
+    {
+        string name;
+        double ms = 0;
+        size_t opsBefore = 0, opsAfter = 0;
+        size_t tensorsBefore = 0, tensorsAfter = 0;
+        bool changed = false;
+    };
+
+    struct PassReport
+    {
+        vector<PassStats> passes;
+        double totalMs = 0;
+
+        bool changed() const;
+        string toString() const;
+    };
+
+    /**
+     * @brief Ordered list of graph passes. Each pass is timed and the
+     * graph's op and tensor counts are recorded around it. With validation
+     * on, the default in debug builds, the graph is checked after every pass
+     * and a broken graph is reported together with the pass that broke it.
+     */
+    class PassManager
+    {
+    private:
+        vector<Ref<GraphPass>> passes;
+#ifdef DEBUG_MODE
+        bool validate = true;
+#else
+        bool validate = false;
+#endif
+
+    public:
+        // The passes of `level`, in the order they run
+        static PassManager create(OptLevel level);
+
+        void addPass(Ref<GraphPass> pass);
+        // Insert before the pass named `before`, or append when absent
+        void insertPass(const string &before, Ref<GraphPass> pass);
+        // Return whether a pass named `name` was removed
+        bool removePass(const string &name);
+        vector<string> getPassNames() const;
+        void setValidate(bool validate_);
+        bool getValidate() const;
+
+        PassReport run(GraphObj &graph) const;
+    };
+
+} // namespace infini
+
+#endif // PASS_MANAGER_H
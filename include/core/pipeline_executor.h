@@ -0,0 +1,115 @@
+#pragma once
+#ifndef PIPELINE_EXECUTOR_H
+#define PIPELINE_EXECUTOR_H
+
+#include "core/runtime.h"
+#include "utils/bounded_queue.h"
+#include <exception>
+#include <functional>
+
+namespace infini
+{
+    /**
+     * @brief Pipeline-parallel execution of one graph. The topologically
+     * sorted ops are cut into contiguous stages of balanced estimated cost;
+     * each stage is a copy of its ops bound to its own thread context.
+     * A run splits the batch (dimension 0 of every graph input) into
+     * micro-batches, which flow from stage to stage through bounded queues
+     * so that different stages work on different micro-batches at once.
+     */
+    class PipelineExecutor
+    {
+    public:
+        struct Config
+        {
+            size_t numStages = 2;
+            size_t numMicroBatches = 4;
+            size_t queueDepth = 2; // micro-batches waiting between two stages
+            // Device ids of the stages, stage s uses devices[s % size];
+            // the caller's device when empty
+            vector<int> devices;
+            // Cost of one op, estimateCost when empty
+            std::function<double(const Operator &)> cost;
+        };
+
+        struct StageStats
+        {
+            size_t firstOp = 0;
+            size_t numOps = 0;
+            double estimatedCost = 0;
+            double busyMs = 0;   // time spent working on micro-batches
+            double bubbleMs = 0; // time of the run the stage sat idle
+            double utilization = 0;
+        };
+
+        struct RunStats
+        {
+            double wallMs = 0;
+            vector<StageStats> stages;
+            string toString() const;
+        };
+
+    private:
+        // Activations of one micro-batch, keyed by the original tensors
+        struct MicroBatch
+        {
+            size_t index = 0;
+            std::unordered_map<TensorObj *, vector<uint8_t>> tensors;
+            std::exception_ptr error;
+        };
+
+        struct Stage
+        {
+            std::thread thread;
+            int deviceId = 0;
+            Graph graph;
+            std::unordered_map<TensorObj *, Tensor> tensors; // original -> stage
+            TensorVec inputs;           // original tensors read from the batch
+            TensorVec outputs;          // original tensors added to the batch
+            vector<TensorObj *> expired; // not needed by later stages
+            // Weights uploaded by the stage's thread when it runs on another
+            // device than the caller
+            vector<pair<Tensor, vector<uint8_t>>> weights;
+            double busyMs = 0;
+        };
+
+        Runtime runtime;
+        Config config;
+        vector<std::unique_ptr<Stage>> stages;
+        vector<std::unique_ptr<BoundedQueue<MicroBatch>>> queues; // queues[s] feeds stage s
+        TensorVec graphInputs, graphOutputs;
+        std::unordered_map<TensorObj *, vector<uint8_t>> results;
+        RunStats stats;
+
+    public:
+        /**
+         * @param inputs Graph inputs fed by run(); other tensors without a
+         * source op are weights shared by all micro-batches.
+         */
+        PipelineExecutor(Runtime runtime, const Graph &graph, TensorVec inputs,
+                         Config config);
+        PipelineExecutor(const PipelineExecutor &) = delete;
+        PipelineExecutor &operator=(const PipelineExecutor &) = delete;
+        ~PipelineExecutor();
+
+        // Run the full batch given as host data of every graph input
+        void run(const std::map<Tensor, const void *> &inputs);
+        // Copy a graph output of the latest run to host memory
+        void getOutput(const Tensor &tensor, void *dst) const;
+        const RunStats &getStats() const;
+        const Graph &getStageGraph(size_t stage) const;
+
+        // First op of every stage, minimizing the cost of the largest stage
+        static vector<size_t> partition(const vector<double> &costs, size_t numStages);
+        // Multiply-adds of a Gemm, output elements of any other op
+        static double estimateCost(const Operator &op);
+
+    private:
+        void buildStages(const Graph &graph, const vector<size_t> &firstOps);
+        void stageLoop(size_t idx, infiniDevice_t device);
+        void process(Stage &stage, MicroBatch &batch);
+    };
+
+} // namespace infini
+
+#endif // PIPELINE_EXECUTOR_H
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef PLAN_CACHE_H
+#define PLAN_CACHE_H
+
+#include "core/execution_plan.h"
+#include "core/memory_planner.h"
+#include "core/offload.h"
+#include <list>
+
+namespace infini
+{
+    /**
+     * @brief Everything a graph prepared for one set of input shapes: tensor
+     * shapes and storage, the memory layout, op descriptors and the launch
+     * records with their kernel choices.
+     */
+    struct PreparedShape
+    {
+        struct TensorState
+        {
+            Shape shape;
+            Stride stride;
+            Blob data;
+        };
+
+        struct OpState
+        {
+            Ref<void> opDesc;
+            void *infiniOpDesc = nullptr;
+            string descKey;
+            infiniopHandle_t descHandle = nullptr;
+            const Kernel *kernel = nullptr;
+            infiniDevice_t kernelDevice = INFINI_DEVICE_CPU;
+            size_t kernelEpoch = 0;
+        };
+
+        std::unordered_map<TensorObj *, TensorState> tensors;
+        std::unordered_map<OperatorObj *, OpState> ops;
+        MemoryPlan memoryPlan;
+        Blob arena;
+        optional<size_t> workspaceSize;
+        Ref<OffloadManager> offloader;
+        Ref<ExecutionPlan> plan;
+    };
+
+    /**
+     * @brief Least recently used cache of PreparedShape keyed by the shapes
+     * of the graph inputs. Each entry keeps its activation buffers alive, so
+     * the capacity bounds the extra memory.
+     */
+    class PlanCache
+    {
+    public:
+        static constexpr size_t kDefaultCapacity = 8;
+
+    private:
+        std::list<pair<string, PreparedShape>> entries; // most recent first
+        size_t capacity = kDefaultCapacity;
+        size_t hits = 0;
+        size_t misses = 0;
+
+    public:
+        // Bucket of the current shapes of `inputs`
+        static string key(const TensorVec &inputs);
+
+        // Entry for `key`, null on a miss
+        const PreparedShape *find(const string &key);
+        void insert(const string &key, PreparedShape entry);
+        void clear();
+        void setCapacity(size_t capacity_);
+
+        size_t size() const;
+        size_t getHits() const;
+        size_t getMisses() const;
+    };
+
+} // namespace infini
+
+#endif // PLAN_CACHE_H
@@ -1,7 +1,12 @@
 #pragma once
 #ifndef RUNTIME_H
 #define RUNTIME_H
+#include "core/allocator.h"
+#include "core/async_run.h"
+#include "core/autotuner.h"
+#include "core/descriptor_cache.h"
 #include "core/kernel.h"
+#include "core/staging_pool.h"
 #include "core/graph.h"
 #include <infiniop/handle.h>
 #include <infinirt.h>
@@ -18,6 +23,17 @@ namespace infini
     infiniDevice_t device = CURRENT_DEVICE_TYPE;
     int deviceId = CURRENT_DEVICE_ID;
     infinirtStream_t stream = nullptr;
+    // 每个 Context 独占的 workspace，按需增长，不与其他 stream 共享
+    void *workspace = nullptr;
+    size_t workspaceSize = 0;
+    // 每个 Context 一个 infiniop handle，算子描述符按 key 缓存复用
+    infiniopHandle_t handle = nullptr;
+    DescriptorCache descriptors;
+
+    ContextObj() = default;
+    ContextObj(const ContextObj &) = delete;
+    ContextObj &operator=(const ContextObj &) = delete;
+    ~ContextObj();
   };
   using Context = Ref<ContextObj>;
 
@@ -27,11 +43,14 @@ namespace infini
     // 全局 map: thread_id -> Context
     std::unordered_map<std::thread::id, Context> threadContexts;
     std::mutex mtx; // 保护 map
-    size_t workspaceSize;
-    void *workspace;
+    mutable CachingAllocator allocator;
+    StagingPool stagingPool;
+    mutable Autotuner autotuner;
+    size_t memoryBudget = 0;
+    size_t maxInFlightRuns = 2;
 
   public:
-    RuntimeObj() { allocworkspace(); }
+    RuntimeObj() = default;
     RuntimeObj(const RuntimeObj &) = delete;
     RuntimeObj &operator=(const RuntimeObj &) = delete;
 
@@ -40,29 +59,71 @@ namespace infini
 
     // 每个线程初始化自己的 Context
     void initThreadContext(infiniDevice_t device, int deviceId);
+    // 线程退出前释放自己的 Context：归还 workspace 并从全局 map 中移除
+    void releaseThreadContext();
 
     // 获取活跃 Context
     Context getCurrentThreadContext() const;
+    // 当前线程 Context 的 stream，未初始化时为 nullptr
+    infinirtStream_t getCurrentStream() const;
     void setCurrentDevice(infiniDevice_t device, int deviceId);
+    // 当前线程 Context 的 infiniop handle 与描述符缓存
+    infiniopHandle_t getHandle() const;
+    DescriptorCache &getDescriptorCache() const;
 
     static void init();
     static void getAllDeviceCount(int *count_array);
+    /**
+     * @brief 为当前线程 Context 预先解析 graph 中每个算子的 kernel、描述符、
+     * workspace 大小与数据指针，之后的 run 直接按记录依次发射。
+     * 张量重新绑定存储（bindExternal、attachBlob 等）后无需再次调用，
+     * 下次 run 前会重新读取这些张量的数据指针。
+     * level 高于 graph 已有的优化级别时，先按该级别的 pass 列表改写 graph，
+     * 各 pass 的耗时与节点数见 GraphObj::getPassReport。
+     */
+    void prepare(const Graph &graph, OptLevel level = OptLevel::O0) const;
     void run(const Graph &graph) const;
+    /**
+     * @brief 在当前线程 Context 的 stream 上异步执行 graph，立即返回与 stream
+     * 完成绑定的 RunFuture。inputs 为 graph 输入张量到 host 数据的映射，拷贝在
+     * 返回前完成，调用方可立即复用。每个在途请求使用独立的激活缓冲区，在途
+     * 请求数达到上限时等待最早的请求完成。
+     */
+    RunFuture runAsync(const Graph &graph,
+                       const std::map<Tensor, const void *> &inputs) const;
+    // runAsync 允许同时在途的请求数，默认为 2
+    void setMaxInFlightRuns(size_t n);
+    size_t getMaxInFlightRuns() const;
     void *allocHost(size_t size);
-    void *allocDevice(size_t size);
+    void *allocDevice(size_t size) const;
     void deallocHost(void *ptr);
-    void deallocDevice(void *ptr);
+    void deallocDevice(void *ptr) const;
     void memcpy(void *dst, const void *src, size_t size, infinirtMemcpyKind_t kind);
     void memcpyAsync(void *dst, const void *src, size_t size, infinirtMemcpyKind_t kind, infinirtStream_t stream);
     void *mallocAsync(size_t size, infinirtStream_t stream);
     void freeAsync(void *ptr, infinirtStream_t stream);
     void synchronize() const;
+    void streamSynchronize(infinirtStream_t stream) const;
+    // 释放缓存分配器中所有空闲的 segment
+    void emptyCache();
+    const CachingAllocator &getAllocator() const;
+    // 可复用的 pinned host 缓冲区，用于 host 与 device 之间的拷贝
+    StagingPool &getStagingPool();
+    // 在同一算子的多个 kernel 变体间选择，结果可持久化到调优缓存文件
+    Autotuner &getAutotuner() const;
+    // 图可使用的 device 内存上限（字节），0 表示不限制；超出时在 dataMalloc 中
+    // 启用 host offload
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+    // 当前线程 Context 的 workspace
     size_t getWorkspaceSize() const;
     void *getWorkspace(size_t size) const;
+    void reserveWorkspace(size_t size) const;
 
     // string toString() const;
+
   private:
-    void allocworkspace();
+    void runPlan(const Graph &graph, ExecutionPlan &plan) const;
   };
 } // namespace infini
 #endif // RUNTIME_H
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef STAGING_POOL_H
+#define STAGING_POOL_H
+
+#include "core/common.h"
+#include <infinirt.h>
+#include <mutex>
+
+namespace infini
+{
+    /**
+     * @brief Pool of reusable pinned host buffers for host<->device copies.
+     * A buffer released with a stream becomes available again once the work
+     * queued on that stream (typically the async copy reading it) completes.
+     */
+    class StagingPool
+    {
+    public:
+        static constexpr size_t kMinBufferSize = 4096;
+
+    private:
+        struct Buffer
+        {
+            void *ptr;
+            size_t size;
+            bool inUse = false;
+            infinirtEvent_t event = nullptr; // pending async use, if any
+        };
+
+        mutable std::mutex mtx;
+        vector<Buffer> buffers;
+        size_t hits = 0;
+        size_t misses = 0;
+
+    public:
+        StagingPool() = default;
+        StagingPool(const StagingPool &) = delete;
+        StagingPool &operator=(const StagingPool &) = delete;
+        ~StagingPool() = default;
+
+        // Get a pinned buffer of at least `size` bytes
+        void *acquire(size_t size);
+        // Buffer is immediately reusable
+        void release(void *ptr);
+        // Buffer is reusable after work queued on `stream` so far has finished
+        void release(void *ptr, infinirtStream_t stream);
+        // Free all idle buffers
+        void clear();
+
+        size_t getHits() const;
+        size_t getMisses() const;
+        size_t getCachedBytes() const;
+
+    private:
+        Buffer &find(void *ptr);
+        bool isReady(Buffer &buffer);
+    };
+
+} // namespace infini
+
+#endif // STAGING_POOL_H
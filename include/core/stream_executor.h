@@ -0,0 +1,80 @@
+#pragma once
+#ifndef STREAM_EXECUTOR_H
+#define STREAM_EXECUTOR_H
+
+#include "core/runtime.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+
+namespace infini
+{
+    /**
+     * @brief Runs independent branches of a graph on several streams.
+     * Ops are assigned to streams along the predecessor/successor edges: an
+     * op continues the stream of a predecessor it is the first successor of,
+     * otherwise it starts on the least loaded stream. Events are recorded and
+     * waited on only for edges that cross streams. Every stream is driven by
+     * its own worker thread with its own context, hence its own workspace.
+     */
+    class MultiStreamExecutor
+    {
+    public:
+        struct Schedule
+        {
+            vector<int> streamOf;            // stream of every op
+            vector<vector<size_t>> streamOps; // op indices per stream, in order
+            vector<vector<size_t>> waits;     // cross-stream predecessors per op
+            vector<bool> recordEvent;         // op has a cross-stream successor
+            size_t numCrossEdges = 0;
+        };
+
+    private:
+        Runtime runtime;
+        size_t numStreams;
+        infiniDevice_t device;
+        int deviceId;
+
+        vector<std::thread> workers;
+        vector<Context> contexts;
+        std::mutex mtx;
+        std::condition_variable cv;
+        uint64_t generation = 0;
+        size_t finished = 0;
+        bool stopping = false;
+        std::atomic<bool> aborted{false};
+        std::exception_ptr error;
+
+        Graph graph;
+        Ref<ExecutionPlan> plan;
+        Schedule schedule;
+        vector<infinirtEvent_t> events;        // per op, when recordEvent
+        vector<infinirtEvent_t> streamEvents;  // end of each stream's work
+        infinirtEvent_t startEvent = nullptr;
+        std::unique_ptr<std::atomic<uint64_t>[]> recorded; // generation per op
+
+    public:
+        MultiStreamExecutor(Runtime runtime, size_t numStreams);
+        MultiStreamExecutor(const MultiStreamExecutor &) = delete;
+        MultiStreamExecutor &operator=(const MultiStreamExecutor &) = delete;
+        ~MultiStreamExecutor();
+
+        /**
+         * @brief Issue all ops of `graph`. Like RuntimeObj::run, work is
+         * ordered before later work on the calling thread's stream.
+         */
+        void run(const Graph &graph);
+        const Schedule &getSchedule() const;
+
+        static Schedule buildSchedule(const OpVec &ops, size_t numStreams);
+
+    private:
+        void workerLoop(size_t idx);
+        void runStream(size_t idx, uint64_t gen);
+        void rebuild(const Graph &graph);
+        void destroyEvents();
+    };
+
+} // namespace infini
+
+#endif // STREAM_EXECUTOR_H
@@ -20,6 +20,8 @@ namespace infini
         Shape shape;
         Stride stride;
         Blob data = nullptr;
+        bool weight = false;
+        size_t hostWrites = 0;
         vector<WRef<OperatorObj>> targets;
         WRef<OperatorObj> source;
 
@@ -42,12 +44,66 @@ namespace infini
         ElementType getRank() const;
         OpVec getTargets() const;
         Operator getSource() const;
+        // Weights are constant while the graph runs, so an offloaded copy
+        // never has to be written back
+        bool isWeight() const;
+        void setWeight(bool weight_);
 
         string toString() const override;
         // ============= TensorObj Data Operations==============
         void setData(void *data_);
+        /**
+         * @brief Attach a caller-owned buffer of at least getTotalBytes()
+         * bytes to the tensor without copying. The buffer is never freed by
+         * the tensor and the memory planner leaves the tensor alone. Host
+         * buffers must be accessible by the device (e.g. pinned memory) when
+         * the graph runs on an accelerator.
+         */
+        void bindExternal(void *ptr, MemoryLocation location = MemoryLocation::Device);
+        bool isExternal() const;
+        // Use an existing blob (e.g. a view of a mapped file) as storage
+        void attachBlob(Blob blob);
         void dataMalloc(const Runtime &runtime);
 
+        // ============= TensorObj Views==============
+        /**
+         * @brief Views share the blob of this tensor and differ only in
+         * shape, stride and start offset (in elements), so nothing is copied
+         * and writes through a view land in the source. The view is a new
+         * tensor outside any graph; it may be added to one as an input.
+         */
+        Tensor view(Shape shape_, Stride stride_, size_t offset = 0) const;
+        // Dim i of the view is dim perm[i] of this tensor
+        Tensor transpose(const vector<int> &perm) const;
+        // Elements [begin, end) along `axis`
+        Tensor slice(int axis, size_t begin, size_t end) const;
+        // Same elements in a new shape; the tensor must be contiguous
+        Tensor reshape(Shape shape_) const;
+        bool isContiguous() const;
+
+        /**
+         * @brief Copy the getElement() elements of `src`, in row-major order
+         * of the shape, into the tensor. Non-contiguous views are scattered
+         * through the staging buffer; the async variant requires a
+         * contiguous tensor. The data goes through a pinned staging buffer,
+         * so `src` may be reused as soon as the call returns, even for the
+         * async variant.
+         */
+        void copyFromHost(const Runtime &runtime, const void *src);
+        void copyFromHostAsync(const Runtime &runtime, const void *src);
+        // Number of copies from host so far, lets holders of a second copy
+        // of the data (e.g. the offloader) notice updates
+        size_t getHostWrites() const;
+        /**
+         * @brief Copy the tensor's elements to host memory in row-major
+         * order of the shape, gathering non-contiguous views. The async
+         * variant requires a contiguous tensor, is ordered on the current
+         * thread's stream and writes straight into `dst`, which must stay
+         * valid (and should be pinned) until that stream is synchronized.
+         */
+        void copyToHost(const Runtime &runtime, void *dst) const;
+        void copyToHostAsync(const Runtime &runtime, void *dst) const;
+
         template <typename T>
         T getRawDataPtr() const
         {
@@ -65,6 +121,8 @@ namespace infini
         void setSource(const Operator &op);
         void removeTarget(const Operator &op);
         Stride computeContiguousStride(const Shape &shape) const;
+        infinirtMemcpyKind_t hostToData() const;
+        infinirtMemcpyKind_t dataToHost() const;
         bool checkValid() const;
 
         template <typename T>
@@ -0,0 +1,83 @@
+#pragma once
+#ifndef TENSOR_PARALLEL_H
+#define TENSOR_PARALLEL_H
+
+#include "core/collective.h"
+#include "core/runtime.h"
+#include <condition_variable>
+#include <exception>
+
+namespace infini
+{
+    /**
+     * @brief Runs one graph on several ranks, each a worker thread with its
+     * own context and its own copy of the graph. Every Gemm whose B is a
+     * weight (TensorObj::isWeight()) and whose beta is 0 is sharded:
+     *  - Column: rank r keeps columns [r*n/N, (r+1)*n/N) of B and the local
+     *    results are joined by an AllGather along the last axis.
+     *  - Row: rank r keeps rows [r*k/N, (r+1)*k/N) of B, takes the matching
+     *    columns of A through a Split and the partial results are summed by
+     *    an AllReduceSum.
+     * Other ops and tensors are replicated on every rank.
+     */
+    class TensorParallelExecutor
+    {
+    public:
+        enum class ShardMode
+        {
+            Column,
+            Row,
+        };
+
+        struct Config
+        {
+            int worldSize = 2;
+            ShardMode mode = ShardMode::Column;
+            // One endpoint per rank; a shared-memory group when empty
+            vector<Ref<Communicator>> comms;
+        };
+
+    private:
+        struct Rank
+        {
+            std::thread thread;
+            Graph graph;
+            std::unordered_map<TensorObj *, Tensor> tensors; // original -> rank
+        };
+
+        Runtime runtime;
+        Config config;
+        vector<std::unique_ptr<Rank>> ranks;
+        size_t numSharded = 0;
+
+        std::mutex mtx;
+        std::condition_variable cv;
+        uint64_t generation = 0;
+        int finished = 0;
+        bool stopping = false;
+        const std::map<Tensor, const void *> *inputs = nullptr;
+        std::exception_ptr error;
+
+    public:
+        TensorParallelExecutor(Runtime runtime, const Graph &graph, Config config);
+        TensorParallelExecutor(const TensorParallelExecutor &) = delete;
+        TensorParallelExecutor &operator=(const TensorParallelExecutor &) = delete;
+        ~TensorParallelExecutor();
+
+        // Feed graph inputs of the original graph from host memory and run
+        void run(const std::map<Tensor, const void *> &inputs);
+        // Copy the result of a tensor of the original graph to host memory
+        void getOutput(const Tensor &tensor, void *dst) const;
+
+        const Graph &getRankGraph(int rank) const;
+        // Number of Gemm ops split across the ranks
+        size_t getNumSharded() const;
+
+    private:
+        void buildRank(const Graph &graph, int rank);
+        void workerLoop(int rank, infiniDevice_t device, int deviceId);
+    };
+
+} // namespace infini
+
+#endif // TENSOR_PARALLEL_H
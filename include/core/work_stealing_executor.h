@@ -0,0 +1,91 @@
+#pragma once
+#ifndef WORK_STEALING_EXECUTOR_H
+#define WORK_STEALING_EXECUTOR_H
+
+#include "core/runtime.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+
+namespace infini
+{
+    /**
+     * @brief Inter-op parallel executor for INFINI_DEVICE_CPU.
+     * Each op keeps an atomic count of unfinished predecessors; an op whose
+     * count drops to zero is pushed on the deque of the worker that finished
+     * the last predecessor. Workers pop their own deque from the back and
+     * steal from the front of others when idle. Use it in place of
+     * RuntimeObj::run for the runs that should go wide.
+     */
+    class WorkStealingExecutor
+    {
+    public:
+        struct Config
+        {
+            size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+            // CPU ids; worker i is pinned to cpus[i % cpus.size()], empty
+            // leaves placement to the OS. The constructor throws if a worker
+            // cannot be pinned.
+            vector<int> cpus;
+        };
+
+        struct RunStats
+        {
+            double wallMs = 0;
+            double criticalPathMs = 0; // longest dependency chain of op times
+            double totalOpMs = 0;      // sum of all op times
+            size_t steals = 0;
+            string toString() const;
+        };
+
+    private:
+        struct Worker
+        {
+            std::thread thread;
+            Context context;
+            std::mutex mtx;
+            std::deque<size_t> ready;
+        };
+
+        Runtime runtime;
+        Config config;
+        vector<std::unique_ptr<Worker>> workers;
+        std::mutex mtx;
+        std::condition_variable cv;
+        uint64_t generation = 0;
+        size_t idleWorkers = 0;
+        bool stopping = false;
+        std::atomic<size_t> remaining{0};
+        std::atomic<size_t> steals{0};
+        std::atomic<bool> aborted{false};
+        std::exception_ptr error;
+
+        Graph graph;
+        Ref<ExecutionPlan> plan;
+        vector<vector<size_t>> succs, preds;
+        std::unique_ptr<std::atomic<size_t>[]> pending;
+        vector<double> opMs;
+        RunStats stats;
+
+    public:
+        explicit WorkStealingExecutor(Runtime runtime);
+        WorkStealingExecutor(Runtime runtime, Config config);
+        WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+        WorkStealingExecutor &operator=(const WorkStealingExecutor &) = delete;
+        ~WorkStealingExecutor();
+
+        void run(const Graph &graph);
+        // Statistics of the latest run
+        const RunStats &getStats() const;
+
+    private:
+        void workerLoop(size_t idx);
+        bool popOrSteal(size_t idx, size_t &op);
+        void execute(size_t idx, size_t op);
+        void rebuild(const Graph &graph);
+    };
+
+} // namespace infini
+
+#endif // WORK_STEALING_EXECUTOR_H
@@ -0,0 +1,109 @@
+#pragma once
+#include "core/operator.h"
+#include "core/graph.h"
+#include <infiniop/ops/clip.h>
+#include <infiniop/ops/relu.h>
+#include <infinirt.h>
+
+namespace infini
+{
+    enum class ActType : uint8_t
+    {
+        None,
+        Relu,
+        Clip,
+    };
+
+    // Element-wise function applied to an op's output; bounds are used by Clip
+    struct Activation
+    {
+        ActType type = ActType::None;
+        float min = 0.0f, max = 0.0f;
+
+        float apply(float x) const
+        {
+            switch (type)
+            {
+            case ActType::Relu:
+                return std::max(x, 0.0f);
+            case ActType::Clip:
+                return std::min(std::max(x, min), max);
+            default:
+                return x;
+            }
+        }
+        string toString() const;
+    };
+
+    /**
+     * @brief infiniop descriptors applying an activation to `x`, writing
+     * `y` (which may alias `x`). Clip keeps its bounds in a small device
+     * buffer owned by the descriptor.
+     */
+    class ActivationDesc
+    {
+    private:
+        Activation act;
+        infiniopReluDescriptor_t relu = nullptr;
+        infiniopClipDescriptor_t clip = nullptr;
+        void *bounds = nullptr; // {min, max}
+        size_t boundBytes = 0;
+        size_t workspaceSize = 0;
+
+    public:
+        ActivationDesc(infiniopHandle_t handle, const Activation &act,
+                       const Tensor &y, const Tensor &x);
+        ActivationDesc(const ActivationDesc &) = delete;
+        ActivationDesc &operator=(const ActivationDesc &) = delete;
+        ~ActivationDesc();
+
+        size_t getWorkspaceSize() const;
+        void apply(void *workspace, size_t size, void *y, const void *x,
+                   infinirtStream_t stream) const;
+    };
+
+    class ReluObj : public OperatorObj
+    {
+    public:
+        ReluObj(GraphObj *graph, Tensor X, Tensor Y);
+        ReluObj(Unchecked, Tensor X, Tensor Y);
+
+        string toString() const override;
+        Operator clone(const TensorVec &inputs, const TensorVec &outputs) const override;
+        bool addAttrs(DescriptorKey &key) const override;
+        Ref<void> createOpDesc(infiniopHandle_t handle) override;
+        size_t getWorkspaceSize(const RuntimeObj *runtime) override;
+        vector<pair<int, int>> getInplacePairs() const override;
+
+        optional<vector<Shape>> inferShape() override;
+        vector<DataType> inferDataType() const override;
+    };
+
+    class ClipObj : public OperatorObj
+    {
+    private:
+        float min, max;
+
+    public:
+        ClipObj(GraphObj *graph, Tensor X, Tensor Y, float min, float max);
+        ClipObj(Unchecked, Tensor X, Tensor Y, float min, float max);
+
+        string toString() const override;
+        Operator clone(const TensorVec &inputs, const TensorVec &outputs) const override;
+        bool addAttrs(DescriptorKey &key) const override;
+        Ref<void> createOpDesc(infiniopHandle_t handle) override;
+        size_t getWorkspaceSize(const RuntimeObj *runtime) override;
+        vector<pair<int, int>> getInplacePairs() const override;
+
+        optional<vector<Shape>> inferShape() override;
+        vector<DataType> inferDataType() const override;
+        float getMin() const;
+        float getMax() const;
+
+    protected:
+        void addDescAttrs(DescriptorKey &key) const override;
+    };
+
+    // The activation computed by a Relu or Clip op
+    Activation getActivation(const Operator &op);
+} // namespace infini
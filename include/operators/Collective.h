@@ -0,0 +1,76 @@
+#pragma once
+#include "core/collective.h"
+#include "core/graph.h"
+#include "core/operator.h"
+
+namespace infini
+{
+    /**
+     * @brief Y = sum of X over all ranks of `comm`.
+     */
+    class AllReduceSumObj : public OperatorObj
+    {
+    private:
+        Ref<Communicator> comm;
+
+    public:
+        AllReduceSumObj(GraphObj *graph, Tensor X, Tensor Y, Ref<Communicator> comm);
+
+        string toString() const override;
+        Operator clone(const TensorVec &inputs, const TensorVec &outputs) const override;
+        Ref<void> createOpDesc(infiniopHandle_t handle) override;
+        optional<vector<Shape>> inferShape() override;
+        vector<DataType> inferDataType() const override;
+        vector<pair<int, int>> getInplacePairs() const override;
+        const Ref<Communicator> &getCommunicator() const;
+    };
+
+    /**
+     * @brief Y = concatenation of X of all ranks of `comm` along `axis`, in
+     * rank order.
+     */
+    class AllGatherObj : public OperatorObj
+    {
+    private:
+        Ref<Communicator> comm;
+        int axis;
+
+    public:
+        AllGatherObj(GraphObj *graph, Tensor X, Tensor Y, Ref<Communicator> comm,
+                     int axis);
+
+        string toString() const override;
+        Operator clone(const TensorVec &inputs, const TensorVec &outputs) const override;
+        Ref<void> createOpDesc(infiniopHandle_t handle) override;
+        optional<vector<Shape>> inferShape() override;
+        vector<DataType> inferDataType() const override;
+        const Ref<Communicator> &getCommunicator() const;
+        int getAxis() const;
+    };
+
+    /**
+     * @brief Y = part `rank` of X cut into `parts` equal slices along `axis`.
+     * Used to feed a rank its share of a replicated activation.
+     */
+    class SplitObj : public OperatorObj
+    {
+    private:
+        int axis;
+        int rank;
+        int parts;
+
+    public:
+        SplitObj(GraphObj *graph, Tensor X, Tensor Y, int axis, int rank, int parts);
+
+        string toString() const override;
+        Operator clone(const TensorVec &inputs, const TensorVec &outputs) const override;
+        bool addAttrs(DescriptorKey &key) const override;
+        Ref<void> createOpDesc(infiniopHandle_t handle) override;
+        optional<vector<Shape>> inferShape() override;
+        vector<DataType> inferDataType() const override;
+        int getAxis() const;
+        int getRank() const;
+        int getParts() const;
+    };
+
+} // namespace infini
@@ -1,7 +1,9 @@
 #pragma once
 #include "core/operator.h"
 #include "core/graph.h"
+#include "operators/Activation.h"
 #include <infiniop/ops/gemm.h>
+#include <infiniop/ops/rearrange.h>
 
 namespace infini
 {
@@ -13,43 +15,74 @@ namespace infini
         // oppsite to the column-major BLAS.
         float alpha, beta;
         bool transA, transB;
+        // Applied to alpha * A * B + beta * C; a separate pass over Y on
+        // the infiniop path
+        Activation act;
 
     public:
         /**
-         * @brief Construct a new Gemm object.
+         * @brief Descriptors of one Gemm: the product, the broadcast copy of
+         * the bias into Y and the activation applied in place afterwards.
+         */
+        struct Desc
+        {
+            infiniopGemmDescriptor_t gemm = nullptr;
+            infiniopRearrangeDescriptor_t bias = nullptr;
+            std::unique_ptr<ActivationDesc> act;
+            size_t workspaceSize = 0;
+
+            Desc() = default;
+            Desc(const Desc &) = delete;
+            Desc &operator=(const Desc &) = delete;
+            ~Desc();
+        };
+
+        /**
+         * @brief Construct a new Gemm object computing
+         * Y = alpha * A * B + beta * C.
          * @param graph The computation graph that this operator belongs to.
          * @param A The input tensor.
          * @param B The input tensor.
-         * @param Y Y is the output/bias of Matmul. If Gemm do not have bias,
-         * Y should be an empty Ref.
+         * @param Y The output. Should be an empty Ref, it is created by the graph.
+         * @param C Optional bias, unidirectionally broadcast to Y and added on
+         * every run. Without it beta scales the previous content of Y.
          * @param transA If matrix A should be transposed when computing.
          * @param transB If matrix B should be transposed when computing.
          */
         GemmObj(GraphObj *graph, Tensor A, Tensor B, Tensor Y, Tensor C,
                 float alpha = 1.0f, float beta = 1.0f, bool transA = false,
                 bool transB = false);
+        GemmObj(Unchecked, Tensor A, Tensor B, Tensor Y, Tensor C, float alpha,
+                float beta, bool transA, bool transB, Activation act = {});
 
         string toString() const override;
-        ~GemmObj() override
-        {
-            if (infiniOpDesc)
-            {
-                auto err = infiniopDestroyGemmDescriptor((infiniopGemmDescriptor_t)infiniOpDesc);
-                if (err != INFINI_STATUS_SUCCESS)
-                {
-                    std::cerr << "Warning: Gemm descriptor destroy failed with error code "
-                              << err << std::endl;
-                }
-            }
-        }
-
-        void createOpDesc() override;
+        Operator clone(const TensorVec &inputs, const TensorVec &outputs) const override;
+        bool addAttrs(DescriptorKey &key) const override;
+
+        Ref<void> createOpDesc(infiniopHandle_t handle) override;
+        size_t getWorkspaceSize(const RuntimeObj *runtime) override;
         optional<vector<Shape>> inferShape() override;
         vector<DataType> inferDataType() const;
 
         bool getTransA() const;
         bool getTransB() const;
+        /**
+         * @brief Shape and strides of A (`idx` 0) or B (`idx` 1) as they enter
+         * the product: a transposed operand has its last two dims swapped, so
+         * kernels read it in place through the strides.
+         */
+        pair<Shape, Stride> getOperandLayout(int idx) const;
         float getAlpha() const;
         float getBeta() const;
+        // Bias input, null when absent
+        Tensor getBias() const;
+        // Strides of the bias expanded to Y's rank, 0 along broadcast dims
+        Stride getBiasStride() const;
+        const Activation &getActivation() const;
+        // Apply an element-wise activation as part of this op
+        void setActivation(const Activation &act_);
+
+    protected:
+        void addDescAttrs(DescriptorKey &key) const override;
     };
 }
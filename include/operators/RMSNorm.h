@@ -18,16 +18,22 @@ namespace infini
             **/
             RMSNormObj(GraphObj *graph, Tensor X, Tensor Y,
                     Tensor W, float epsilon = 1e-8);
+            RMSNormObj(Unchecked, Tensor X, Tensor Y, Tensor W, float epsilon);
             
             string toString() const override;
-            ~RMSNormObj() override{
-                //TODO
-            }
-            void createOpDesc() override;
+            Operator clone(const TensorVec &inputs, const TensorVec &outputs) const override;
+            bool addAttrs(DescriptorKey &key) const override;
+            Ref<void> createOpDesc(infiniopHandle_t handle) override;
+            size_t getWorkspaceSize(const RuntimeObj *runtime) override;
+            // Y has the shape and dtype of X, so it may overwrite X
+            vector<pair<int, int>> getInplacePairs() const override;
 
             optional<vector<Shape>> inferShape() override;
             vector<DataType> inferDataType() const;
             float getEpsilon() const;
 
+        protected:
+            void addDescAttrs(DescriptorKey &key) const override;
+
     }; // class RMSNormObj
 }
\ No newline at end of file
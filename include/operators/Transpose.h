@@ -0,0 +1,36 @@
+#pragma once
+#include "core/operator.h"
+#include "core/graph.h"
+#include <infiniop/ops/rearrange.h>
+
+namespace infini
+{
+    /**
+     * @brief Y = X with its dims permuted, dim i of Y being dim perm[i] of X.
+     * The kernel materializes Y with a strided copy; consumers that can read
+     * X through permuted strides (see AbsorbTransposePass) avoid the copy.
+     */
+    class TransposeObj : public OperatorObj
+    {
+    private:
+        vector<int> perm;
+
+    public:
+        TransposeObj(GraphObj *graph, Tensor X, Tensor Y, vector<int> perm);
+        TransposeObj(Unchecked, Tensor X, Tensor Y, vector<int> perm);
+
+        string toString() const override;
+        Operator clone(const TensorVec &inputs, const TensorVec &outputs) const override;
+        bool addAttrs(DescriptorKey &key) const override;
+        Ref<void> createOpDesc(infiniopHandle_t handle) override;
+
+        optional<vector<Shape>> inferShape() override;
+        vector<DataType> inferDataType() const override;
+        const vector<int> &getPerm() const;
+        // Whether only the last two dims are swapped
+        bool swapsLastTwoDims() const;
+
+    protected:
+        void addDescAttrs(DescriptorKey &key) const override;
+    };
+} // namespace infini
@@ -0,0 +1,68 @@
+#pragma once
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include "core/common.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace infini
+{
+    /**
+     * @brief Blocking FIFO holding at most `capacity` items. After close(),
+     * push fails and pop drains what is left, then fails.
+     */
+    template <typename T>
+    class BoundedQueue
+    {
+    private:
+        std::mutex mtx;
+        std::condition_variable notFull, notEmpty;
+        std::deque<T> items;
+        size_t capacity;
+        bool closed = false;
+
+    public:
+        explicit BoundedQueue(size_t capacity) : capacity(capacity)
+        {
+            IT_ASSERT(capacity > 0);
+        }
+
+        bool push(T item)
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notFull.wait(lock, [&]
+                         { return closed || items.size() < capacity; });
+            if (closed)
+                return false;
+            items.push_back(std::move(item));
+            notEmpty.notify_one();
+            return true;
+        }
+
+        bool pop(T &item)
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notEmpty.wait(lock, [&]
+                          { return closed || !items.empty(); });
+            if (items.empty())
+                return false;
+            item = std::move(items.front());
+            items.pop_front();
+            notFull.notify_one();
+            return true;
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            closed = true;
+            notFull.notify_all();
+            notEmpty.notify_all();
+        }
+    };
+
+} // namespace infini
+
+#endif // BOUNDED_QUEUE_H
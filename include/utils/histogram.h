@@ -0,0 +1,44 @@
+#pragma once
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "core/common.h"
+
+namespace infini
+{
+    /**
+     * @brief Counts of samples in buckets [bounds[i-1], bounds[i]); the last
+     * bucket holds everything from bounds.back() up.
+     */
+    class Histogram
+    {
+    private:
+        vector<double> bounds;
+        vector<size_t> counts;
+        size_t total = 0;
+        double sum = 0;
+        double maxValue = 0;
+
+    public:
+        explicit Histogram(vector<double> bounds);
+        // Buckets [1, 2), [2, 4), ... up to `limit`
+        static Histogram exponential(double limit);
+        // One bucket per integer in [1, limit]
+        static Histogram linear(size_t limit);
+
+        void add(double value);
+        void clear();
+
+        const vector<double> &getBounds() const;
+        const vector<size_t> &getCounts() const;
+        size_t getTotal() const;
+        double getMean() const;
+        double getMax() const;
+        // Smallest bucket bound below which a fraction `q` of samples fall
+        double getQuantile(double q) const;
+        string toString() const;
+    };
+
+} // namespace infini
+
+#endif // HISTOGRAM_H
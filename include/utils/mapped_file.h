@@ -0,0 +1,31 @@
+#pragma once
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "core/common.h"
+
+namespace infini
+{
+    /**
+     * @brief Read-only view of a whole file mapped into memory. Pages are
+     * mapped copy-on-write, so accidental writes never reach the file.
+     */
+    class MappedFile
+    {
+        void *addr = nullptr;
+        size_t length = 0;
+
+    public:
+        explicit MappedFile(const string &path);
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        ~MappedFile();
+
+        const char *data() const { return static_cast<const char *>(addr); }
+        char *data() { return static_cast<char *>(addr); }
+        size_t size() const { return length; }
+    };
+
+} // namespace infini
+
+#endif // MAPPED_FILE_H
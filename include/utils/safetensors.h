@@ -0,0 +1,46 @@
+#pragma once
+#ifndef SAFETENSORS_H
+#define SAFETENSORS_H
+
+#include "core/graph.h"
+
+namespace infini
+{
+    /**
+     * @brief Loader for the `.safetensors` weight format.
+     * The file is memory-mapped and its JSON header parsed into one TensorObj
+     * per entry. On the CPU device the tensors are bound to the mapped pages
+     * without copying; on other devices the data is streamed through pinned
+     * staging buffers on the current thread's stream.
+     */
+    class SafeTensorsLoader
+    {
+    public:
+        struct Entry
+        {
+            string name;
+            DataType dtype;
+            Shape shape;
+            size_t begin; // byte offsets relative to the data section
+            size_t end;
+        };
+
+        static constexpr size_t kChunkSize = 16 << 20;
+        static constexpr int kMaxInflightChunks = 4;
+
+        /**
+         * @brief Create the weights of a file as tensors of `graph`.
+         * @return Tensors keyed by their name in the file.
+         */
+        static std::map<string, Tensor> load(const Graph &graph, const string &path);
+        // Parse the JSON header of a safetensors file
+        static vector<Entry> parseHeader(const char *header, size_t size);
+
+    private:
+        static void upload(const Runtime &runtime, const Tensor &tensor,
+                           const char *src);
+    };
+
+} // namespace infini
+
+#endif // SAFETENSORS_H
@@ -0,0 +1,278 @@
+#include "core/allocator.h"
+
+namespace infini
+{
+    CachingAllocator::CachingAllocator() : bins(kNumBins), stats(kNumBins) {}
+
+    size_t CachingAllocator::roundSize(size_t size)
+    {
+        if (size < kMinBlockSize)
+            return kMinBlockSize;
+        return (size + kMinBlockSize - 1) / kMinBlockSize * kMinBlockSize;
+    }
+
+    int CachingAllocator::getBin(size_t size)
+    {
+        int bin = 0;
+        while (size > 1 && bin < kNumBins - 1)
+        {
+            size >>= 1;
+            ++bin;
+        }
+        return bin;
+    }
+
+    size_t CachingAllocator::getSegmentSize(size_t size)
+    {
+        if (size <= kSmallSize)
+            return kSmallBuffer;
+        if (size < kMinLargeAlloc)
+            return kLargeBuffer;
+        return (size + kRoundLarge - 1) / kRoundLarge * kRoundLarge;
+    }
+
+    bool CachingAllocator::shouldSplit(const Block *block, size_t size)
+    {
+        size_t remaining = block->size - size;
+        return size <= kSmallSize ? remaining >= kMinBlockSize
+                                  : remaining > kSmallSize;
+    }
+
+    void CachingAllocator::insertFree(Block *block)
+    {
+        bins[getBin(block->size)].insert(block);
+    }
+
+    void CachingAllocator::eraseFree(Block *block)
+    {
+        bins[getBin(block->size)].erase(block);
+    }
+
+    CachingAllocator::Block *CachingAllocator::findFreeBlock(size_t size,
+                                                             infinirtStream_t stream)
+    {
+        Block key{nullptr, size, stream};
+        for (int bin = getBin(size); bin < kNumBins; ++bin)
+        {
+            auto it = bins[bin].lower_bound(&key);
+            if (it != bins[bin].end() && (*it)->stream == stream)
+            {
+                Block *block = *it;
+                bins[bin].erase(it);
+                return block;
+            }
+        }
+        return nullptr;
+    }
+
+    CachingAllocator::Block *CachingAllocator::mallocSegment(size_t size,
+                                                             infinirtStream_t stream)
+    {
+        size_t segmentSize = getSegmentSize(size);
+        void *ptr = nullptr;
+        if (infinirtMalloc(&ptr, segmentSize) != INFINI_STATUS_SUCCESS)
+        {
+            // Out of memory: give cached segments back and retry once
+            processPendingBlocks(true);
+            releaseCachedSegments();
+            CHECK_INFINI_ERROR(infinirtMalloc(&ptr, segmentSize));
+        }
+        reservedBytes += segmentSize;
+        return new Block{ptr, segmentSize, stream};
+    }
+
+    void *CachingAllocator::alloc(size_t size, infinirtStream_t stream)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        size = roundSize(size);
+        processPendingBlocks(false);
+        auto &binStats = stats[getBin(size)];
+
+        Block *block = findFreeBlock(size, stream);
+        if (block)
+        {
+            ++binStats.hits;
+        }
+        else
+        {
+            ++binStats.misses;
+            block = mallocSegment(size, stream);
+        }
+
+        if (shouldSplit(block, size))
+        {
+            Block *rest = new Block{static_cast<char *>(block->ptr) + size,
+                                    block->size - size, stream};
+            rest->prev = block;
+            rest->next = block->next;
+            if (block->next)
+                block->next->prev = rest;
+            block->next = rest;
+            block->size = size;
+            insertFree(rest);
+        }
+
+        block->allocated = true;
+        activeBlocks[block->ptr] = block;
+        allocatedBytes += block->size;
+        return block->ptr;
+    }
+
+    void CachingAllocator::free(void *ptr)
+    {
+        if (!ptr)
+            return;
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = activeBlocks.find(ptr);
+        IT_ASSERT(it != activeBlocks.end(), "Freeing a pointer not owned by allocator");
+        Block *block = it->second;
+        activeBlocks.erase(it);
+        allocatedBytes -= block->size;
+        releaseBlock(block);
+    }
+
+    void CachingAllocator::free(void *ptr, infinirtStream_t stream)
+    {
+        if (!ptr)
+            return;
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = activeBlocks.find(ptr);
+        IT_ASSERT(it != activeBlocks.end(), "Freeing a pointer not owned by allocator");
+        Block *block = it->second;
+        activeBlocks.erase(it);
+        allocatedBytes -= block->size;
+        if (stream == block->stream)
+        {
+            // Later users of this block are queued behind the releasing work
+            releaseBlock(block);
+            return;
+        }
+        infinirtEvent_t event = nullptr;
+        CHECK_INFINI_ERROR(infinirtEventCreate(&event));
+        CHECK_INFINI_ERROR(infinirtEventRecord(event, stream));
+        pendingBlocks.emplace_back(block, event);
+    }
+
+    void CachingAllocator::processPendingBlocks(bool wait)
+    {
+        for (auto it = pendingBlocks.begin(); it != pendingBlocks.end();)
+        {
+            auto [block, event] = *it;
+            if (wait)
+            {
+                CHECK_INFINI_ERROR(infinirtEventSynchronize(event));
+            }
+            else
+            {
+                infinirtEventStatus_t status;
+                CHECK_INFINI_ERROR(infinirtEventQuery(event, &status));
+                if (status != INFINIRT_EVENT_COMPLETE)
+                {
+                    ++it;
+                    continue;
+                }
+            }
+            CHECK_INFINI_ERROR(infinirtEventDestroy(event));
+            releaseBlock(block);
+            it = pendingBlocks.erase(it);
+        }
+    }
+
+    void CachingAllocator::releaseBlock(Block *block)
+    {
+        block->allocated = false;
+
+        // Merge with free neighbours of the same segment
+        if (Block *prev = block->prev; prev && !prev->allocated)
+        {
+            eraseFree(prev);
+            prev->size += block->size;
+            prev->next = block->next;
+            if (block->next)
+                block->next->prev = prev;
+            delete block;
+            block = prev;
+        }
+        if (Block *next = block->next; next && !next->allocated)
+        {
+            eraseFree(next);
+            block->size += next->size;
+            block->next = next->next;
+            if (next->next)
+                next->next->prev = block;
+            delete next;
+        }
+        insertFree(block);
+    }
+
+    void CachingAllocator::releaseCachedSegments()
+    {
+        for (auto &bin : bins)
+        {
+            for (auto it = bin.begin(); it != bin.end();)
+            {
+                Block *block = *it;
+                if (block->prev == nullptr && block->next == nullptr)
+                {
+                    CHECK_INFINI_ERROR(infinirtFree(block->ptr));
+                    reservedBytes -= block->size;
+                    delete block;
+                    it = bin.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    void CachingAllocator::emptyCache()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        processPendingBlocks(true);
+        releaseCachedSegments();
+    }
+
+    vector<CachingAllocator::BinStats> CachingAllocator::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return stats;
+    }
+
+    size_t CachingAllocator::getAllocatedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return allocatedBytes;
+    }
+
+    size_t CachingAllocator::getReservedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return reservedBytes;
+    }
+
+    size_t CachingAllocator::getPendingBlocks() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return pendingBlocks.size();
+    }
+
+    string CachingAllocator::toString() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::ostringstream oss;
+        oss << "CachingAllocator(allocated=" << allocatedBytes
+            << "B, reserved=" << reservedBytes << "B)\n";
+        for (int bin = 0; bin < kNumBins; ++bin)
+        {
+            if (stats[bin].hits == 0 && stats[bin].misses == 0)
+                continue;
+            oss << "  bin 2^" << bin << ": hits=" << stats[bin].hits
+                << ", misses=" << stats[bin].misses
+                << ", cached blocks=" << bins[bin].size() << "\n";
+        }
+        return oss.str();
+    }
+
+} // namespace infini
@@ -0,0 +1,253 @@
+#include "core/async_run.h"
+#include "core/graph.h"
+#include "core/runtime.h"
+
+namespace infini
+{
+    RunFuture::RunFuture(RunFuture &&other) noexcept
+        : runtime(std::move(other.runtime)), stream(other.stream),
+          event(std::move(other.event)), outputs(std::move(other.outputs))
+    {
+        other.outputs.clear();
+    }
+
+    RunFuture &RunFuture::operator=(RunFuture &&other) noexcept
+    {
+        if (this != &other)
+        {
+            releaseOutputs();
+            runtime = std::move(other.runtime);
+            stream = other.stream;
+            event = std::move(other.event);
+            outputs = std::move(other.outputs);
+            other.outputs.clear();
+        }
+        return *this;
+    }
+
+    RunFuture::~RunFuture() { releaseOutputs(); }
+
+    void RunFuture::releaseOutputs()
+    {
+        if (!runtime)
+            return;
+        auto &staging = runtime->getStagingPool();
+        for (auto &[tensor, buffer] : outputs)
+        {
+            // The copy into the buffer may still be queued
+            if (ready())
+                staging.release(buffer.first);
+            else
+                staging.release(buffer.first, stream);
+        }
+        outputs.clear();
+    }
+
+    bool RunFuture::valid() const { return event != nullptr; }
+
+    bool RunFuture::ready() const
+    {
+        IT_ASSERT(valid(), "Future has no associated run");
+        infinirtEventStatus_t status;
+        CHECK_INFINI_ERROR(infinirtEventQuery(event.get(), &status));
+        return status == INFINIRT_EVENT_COMPLETE;
+    }
+
+    void RunFuture::wait() const
+    {
+        IT_ASSERT(valid(), "Future has no associated run");
+        CHECK_INFINI_ERROR(infinirtEventSynchronize(event.get()));
+    }
+
+    void RunFuture::getOutput(const Tensor &tensor, void *dst) const
+    {
+        auto it = outputs.find(tensor.get());
+        IT_ASSERT(it != outputs.end(), "Tensor is not an output of the graph");
+        wait();
+        std::memcpy(dst, it->second.first, it->second.second);
+    }
+
+    AsyncRunPool::AsyncRunPool(const Graph &graph, Ref<ExecutionPlan> plan_,
+                               const std::set<TensorObj *> &inputs_,
+                               size_t numSlots)
+        : runtime(graph->getRuntime()), plan(std::move(plan_)), inputs(inputs_),
+          slots(numSlots)
+    {
+        IT_ASSERT(numSlots > 0);
+        IT_ASSERT(!plan->refreshData,
+                  "Asynchronous runs do not support host offloading");
+        // Declared outputs may also feed other ops; without them every
+        // produced tensor nothing reads is an output
+        if (!graph->getOutputs().empty())
+        {
+            for (auto &tensor : graph->getOutputs())
+            {
+                if (tensor->getSource() || inputs.count(tensor.get()))
+                    outputs.push_back(tensor);
+            }
+        }
+        else
+        {
+            for (auto &tensor : graph->getTensors())
+            {
+                if (tensor->getSource() && tensor->getTargets().empty())
+                    outputs.push_back(tensor);
+            }
+        }
+
+        // Activations of the graph: the arena, tensors produced by an op and
+        // the graph inputs fed by the caller
+        const auto &memoryPlan = graph->getMemoryPlan();
+        TensorVec pinned;
+        for (auto &tensor : graph->getTensors())
+        {
+            if (!memoryPlan.isPlanned(tensor) &&
+                (tensor->getSource() || inputs.count(tensor.get())))
+                pinned.push_back(tensor);
+        }
+
+        infinirtStream_t stream = runtime->getCurrentStream();
+        for (size_t idx = 0; idx < numSlots; ++idx)
+        {
+            auto &slot = slots[idx];
+            slot.records = plan->records;
+            if (idx == 0)
+            {
+                for (auto &tensor : graph->getTensors())
+                {
+                    if (memoryPlan.isPlanned(tensor) || inputs.count(tensor.get()) ||
+                        tensor->getSource())
+                        slot.buffers[tensor.get()] = tensor->getRawDataPtr<void *>();
+                }
+                continue;
+            }
+            // Released behind the runs queued on this stream
+            auto alloc = [&](size_t size)
+            {
+                slot.blobs.push_back(make_ref<BlobObj>(
+                    runtime, runtime->allocDevice(size), stream));
+                return slot.blobs.back()->getPtr<char *>();
+            };
+            if (memoryPlan.arenaSize > 0)
+            {
+                char *arena = alloc(memoryPlan.arenaSize);
+                for (auto &[tensor, offset] : memoryPlan.offsets)
+                    slot.buffers[tensor] = arena + offset;
+            }
+            for (auto &tensor : pinned)
+                slot.buffers[tensor.get()] = alloc(tensor->getTotalBytes());
+
+            for (auto &record : slot.records)
+            {
+                for (uint32_t i = 0; i < record.numOutputs + record.numInputs; ++i)
+                {
+                    auto tensor = i < record.numOutputs
+                                      ? record.op->getOutput(i)
+                                      : record.op->getInput(i - record.numOutputs);
+                    auto it = slot.buffers.find(tensor.get());
+                    if (it != slot.buffers.end())
+                        record.data[i] = it->second;
+                }
+            }
+        }
+    }
+
+    AsyncRunPool::~AsyncRunPool()
+    {
+        try
+        {
+            drain();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Warning: waiting for async runs failed: " << e.what()
+                      << std::endl;
+        }
+    }
+
+    Ref<void> AsyncRunPool::recordEvent(infinirtStream_t stream)
+    {
+        infinirtEvent_t event = nullptr;
+        CHECK_INFINI_ERROR(infinirtEventCreate(&event));
+        CHECK_INFINI_ERROR(infinirtEventRecord(event, stream));
+        return Ref<void>(event, [](void *e)
+                         { infinirtEventDestroy(static_cast<infinirtEvent_t>(e)); });
+    }
+
+    RunFuture AsyncRunPool::run(const std::map<Tensor, const void *> &data)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto context = runtime->getCurrentThreadContext();
+        infinirtStream_t stream = context->stream;
+        auto &slot = slots[next];
+        next = (next + 1) % slots.size();
+        // Bound the number of runs in flight: the slot's previous run must
+        // be done before its buffers are overwritten
+        if (slot.event)
+            CHECK_INFINI_ERROR(infinirtEventSynchronize(slot.event.get()));
+
+        auto &staging = runtime->getStagingPool();
+        for (auto &[tensor, src] : data)
+        {
+            auto it = slot.buffers.find(tensor.get());
+            IT_ASSERT(it != slot.buffers.end(), "Tensor is not a graph input");
+            size_t bytes = tensor->getTotalBytes();
+            void *buffer = staging.acquire(bytes);
+            std::memcpy(buffer, src, bytes);
+            runtime->memcpyAsync(it->second, buffer, bytes, INFINIRT_MEMCPY_H2D,
+                                 stream);
+            staging.release(buffer, stream);
+        }
+
+        runtime->reserveWorkspace(plan->workspaceSize);
+        void *workspace = context->workspace;
+        for (const auto &record : slot.records)
+            record.kernel->launch(record, workspace, stream, runtime.get());
+
+        RunFuture future;
+        future.runtime = runtime;
+        future.stream = stream;
+        for (auto &tensor : outputs)
+        {
+            size_t bytes = tensor->getTotalBytes();
+            void *buffer = staging.acquire(bytes);
+            runtime->memcpyAsync(buffer, slot.buffers.at(tensor.get()), bytes,
+                                 INFINIRT_MEMCPY_D2H, stream);
+            future.outputs[tensor.get()] = {buffer, bytes};
+        }
+        slot.event = recordEvent(stream);
+        future.event = slot.event;
+        return future;
+    }
+
+    bool AsyncRunPool::matches(const Ref<ExecutionPlan> &plan_,
+                               const std::map<Tensor, const void *> &data,
+                               size_t numSlots) const
+    {
+        if (plan != plan_ || slots.size() != numSlots || data.size() != inputs.size())
+            return false;
+        return std::all_of(data.begin(), data.end(), [&](const auto &entry)
+                           { return inputs.count(entry.first.get()) > 0; });
+    }
+
+    void AsyncRunPool::drain()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto &slot : slots)
+        {
+            if (slot.event)
+                CHECK_INFINI_ERROR(infinirtEventSynchronize(slot.event.get()));
+        }
+    }
+
+    size_t AsyncRunPool::getNumSlots() const { return slots.size(); }
+
+    void *AsyncRunPool::getBuffer(size_t idx, const Tensor &tensor) const
+    {
+        IT_ASSERT(idx < slots.size());
+        auto it = slots[idx].buffers.find(tensor.get());
+        IT_ASSERT(it != slots[idx].buffers.end(), "Tensor has no per-run buffer");
+        return it->second;
+    }
+
+} // namespace infini
@@ -0,0 +1,202 @@
+#include "core/autotuner.h"
+#include "core/runtime.h"
+#include <chrono>
+#include <cstdlib>
+
+namespace infini
+{
+    Autotuner::Autotuner()
+    {
+        newEpoch();
+        if (const char *path = std::getenv("INFINI_TUNING_CACHE"))
+            setCachePath(path);
+    }
+
+    void Autotuner::newEpoch()
+    {
+        // Unique across tuners, so ops never keep a choice of another one
+        static std::atomic<size_t> counter = 0;
+        epoch.store(++counter);
+    }
+
+    void Autotuner::setCachePath(const string &path)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        cachePath = path;
+        load(path);
+        newEpoch();
+    }
+
+    void Autotuner::setEnabled(bool enabled_)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        enabled = enabled_;
+        newEpoch();
+    }
+
+    bool Autotuner::isEnabled() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return enabled;
+    }
+
+    size_t Autotuner::getNumTuned() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return numTuned;
+    }
+
+    size_t Autotuner::getNumSelects() const { return numSelects.load(); }
+
+    size_t Autotuner::size() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return winners.size();
+    }
+
+    void Autotuner::clear()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        winners.clear();
+        newEpoch();
+    }
+
+    string Autotuner::signature(infiniDevice_t device, const Operator &op)
+    {
+        static const char *digits = "0123456789abcdef";
+        const auto &key = op->getDescKey().str();
+        string sig = std::to_string(device) + ":";
+        sig.reserve(sig.size() + key.size() * 2);
+        for (unsigned char c : key)
+        {
+            sig.push_back(digits[c >> 4]);
+            sig.push_back(digits[c & 15]);
+        }
+        return sig;
+    }
+
+    const Kernel *Autotuner::select(const Operator &op, const RuntimeObj *runtime)
+    {
+        ++numSelects;
+        auto device = runtime->getCurrentThreadContext()->device;
+        size_t current = epoch.load();
+        if (op->kernel && op->kernelDevice == device && op->kernelEpoch == current)
+            return op->kernel;
+        auto kernel = choose(device, op, runtime);
+        op->kernel = kernel;
+        op->kernelDevice = device;
+        op->kernelEpoch = current;
+        return kernel;
+    }
+
+    const Kernel *Autotuner::choose(infiniDevice_t device, const Operator &op,
+                                    const RuntimeObj *runtime)
+    {
+        const auto &items = KernelRegistry::getInstance().getKernelItems(
+            KernelAttrs{device, op->getOpType().underlying()});
+        if (items.size() == 1)
+            return std::get<0>(items.front());
+
+        vector<const KernelRegistry::KernelRecord *> candidates;
+        for (auto &item : items)
+        {
+            if (std::get<0>(item)->isApplicable(op))
+                candidates.push_back(&item);
+        }
+        IT_ASSERT(!candidates.empty(), "No applicable kernel for " + op->toString());
+        if (candidates.size() == 1 || !isEnabled())
+            return std::get<0>(*candidates.front());
+
+        auto sig = signature(device, op);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto it = winners.find(sig);
+            if (it != winners.end())
+            {
+                for (auto candidate : candidates)
+                {
+                    if (std::get<1>(*candidate) == it->second)
+                        return std::get<0>(*candidate);
+                }
+                // The stored winner is gone (e.g. a different build), retune
+            }
+        }
+        return tune(sig, op, runtime, candidates);
+    }
+
+    const Kernel *Autotuner::tune(const string &sig, const Operator &op,
+                                  const RuntimeObj *runtime,
+                                  const vector<const KernelRegistry::KernelRecord *> &candidates)
+    {
+        LaunchRecord record;
+        record.op = op;
+        record.desc = op->getInfiniOpDesc(runtime);
+        record.workspaceSize = op->getWorkspaceSize(runtime);
+        ExecutionPlan::fillData(record);
+        // Outputs go to scratch buffers, so the inputs of in-place ops and
+        // accumulated outputs are left untouched
+        vector<void *> scratch;
+        for (size_t i = 0; i < record.numOutputs; ++i)
+        {
+            scratch.push_back(runtime->allocDevice(op->getOutput(i)->getTotalBytes()));
+            record.data[i] = scratch.back();
+        }
+        void *workspace = runtime->getWorkspace(record.workspaceSize);
+        auto stream = runtime->getCurrentStream();
+
+        const KernelRegistry::KernelRecord *best = nullptr;
+        double bestTime = 0;
+        for (auto candidate : candidates)
+        {
+            auto kernel = std::get<0>(*candidate);
+            for (int i = 0; i < kWarmup; ++i)
+                kernel->launch(record, workspace, stream, runtime);
+            runtime->streamSynchronize(stream);
+            auto begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i)
+                kernel->launch(record, workspace, stream, runtime);
+            runtime->streamSynchronize(stream);
+            double time = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - begin)
+                              .count();
+            if (!best || time < bestTime)
+            {
+                best = candidate;
+                bestTime = time;
+            }
+        }
+        for (auto ptr : scratch)
+            runtime->deallocDevice(ptr);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        winners[sig] = std::get<1>(*best);
+        ++numTuned;
+        save();
+        return std::get<0>(*best);
+    }
+
+    void Autotuner::load(const string &path)
+    {
+        std::ifstream in(path);
+        string sig, name;
+        while (in >> sig >> name)
+            winners[sig] = name;
+    }
+
+    void Autotuner::save() const
+    {
+        if (cachePath.empty())
+            return;
+        // Write a new file and rename it so readers never see a partial one
+        string tmpPath = cachePath + ".tmp";
+        {
+            std::ofstream out(tmpPath, std::ios::trunc);
+            IT_ASSERT(out.good(), "Cannot open tuning cache " + tmpPath);
+            for (auto &[sig, name] : winners)
+                out << sig << " " << name << "\n";
+        }
+        IT_ASSERT(std::rename(tmpPath.c_str(), cachePath.c_str()) == 0,
+                  "Cannot write tuning cache " + cachePath);
+    }
+
+} // namespace infini
@@ -0,0 +1,171 @@
+#include "core/batcher.h"
+
+namespace infini
+{
+    string DynamicBatcher::Stats::toString() const
+    {
+        std::ostringstream oss;
+        oss << "DynamicBatcher(requests=" << requests << ", batches=" << batches
+            << ")\n  queue delay (us): " << queueDelayUs.toString()
+            << "\n  batch size: " << batchSize.toString();
+        return oss.str();
+    }
+
+    DynamicBatcher::DynamicBatcher(Runtime runtime_, Graph graph_, TensorVec inputs_,
+                                   TensorVec outputs_, Config config_)
+        : runtime(std::move(runtime_)), graph(std::move(graph_)),
+          inputs(std::move(inputs_)), outputs(std::move(outputs_)), config(config_)
+    {
+        IT_ASSERT(config.maxBatchSize > 0);
+        IT_ASSERT(!inputs.empty() && !outputs.empty());
+        stats.batchSize = Histogram::linear(config.maxBatchSize);
+        for (auto &input : inputs)
+        {
+            IT_ASSERT(!input->getSource(), "Batched inputs must be graph inputs");
+            IT_ASSERT(input->getRank() > 0 && input->getShape()[0] > 0);
+            inputRowBytes.push_back(input->getTotalBytes() / input->getShape()[0]);
+        }
+        for (auto &output : outputs)
+            IT_ASSERT(output->getRank() > 0, "Outputs need a batch dimension");
+        auto context = runtime->getCurrentThreadContext();
+        worker = std::thread(
+            [this, device = context->device, deviceId = context->deviceId]
+            {
+                runtime->initThreadContext(device, deviceId);
+                workerLoop();
+                runtime->releaseThreadContext();
+            });
+    }
+
+    DynamicBatcher::~DynamicBatcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    std::future<DynamicBatcher::Result>
+    DynamicBatcher::submit(const vector<const void *> &data)
+    {
+        IT_ASSERT(data.size() == inputs.size(), "One row per batched input expected");
+        Request request;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            auto src = static_cast<const uint8_t *>(data[i]);
+            request.inputs.emplace_back(src, src + inputRowBytes[i]);
+        }
+        auto future = request.promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            IT_ASSERT(!stopping, "Batcher is shutting down");
+            request.enqueued = std::chrono::steady_clock::now();
+            queue.push_back(std::move(request));
+        }
+        cv.notify_all();
+        return future;
+    }
+
+    DynamicBatcher::Stats DynamicBatcher::getStats()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return stats;
+    }
+
+    void DynamicBatcher::workerLoop()
+    {
+        while (true)
+        {
+            vector<Request> batch;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]
+                        { return stopping || !queue.empty(); });
+                if (queue.empty())
+                    return;
+                // Wait for a full batch, but never past the oldest deadline
+                auto deadline = queue.front().enqueued + config.maxWait;
+                cv.wait_until(lock, deadline, [&]
+                              { return stopping || queue.size() >= config.maxBatchSize; });
+                auto start = std::chrono::steady_clock::now();
+                size_t n = std::min(queue.size(), config.maxBatchSize);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    auto delay = std::chrono::duration<double, std::micro>(
+                        start - queue.front().enqueued);
+                    stats.queueDelayUs.add(delay.count());
+                    batch.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                }
+                stats.batchSize.add(n);
+                stats.requests += n;
+                ++stats.batches;
+            }
+            try
+            {
+                runBatch(batch);
+            }
+            catch (...)
+            {
+                // A satisfied promise would throw again and terminate the worker
+                for (auto &request : batch)
+                {
+                    if (!request.fulfilled)
+                        request.promise.set_exception(std::current_exception());
+                }
+            }
+        }
+    }
+
+    void DynamicBatcher::runBatch(vector<Request> &batch)
+    {
+        size_t n = batch.size();
+        std::map<Tensor, Shape> shapes;
+        for (auto &input : inputs)
+        {
+            Shape shape = input->getShape();
+            shape[0] = n;
+            shapes[input] = shape;
+        }
+        graph->setInputShapes(shapes);
+        // First batch: storage is planned for its batch size
+        if (!inputs[0]->getData())
+            graph->dataMalloc();
+        auto plan = graph->getPlan();
+        if (!plan || plan->handle != runtime->getHandle())
+            runtime->prepare(graph);
+
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            vector<uint8_t> stacked(n * inputRowBytes[i]);
+            for (size_t r = 0; r < n; ++r)
+                std::memcpy(stacked.data() + r * inputRowBytes[i],
+                            batch[r].inputs[i].data(), inputRowBytes[i]);
+            inputs[i]->copyFromHost(runtime, stacked.data());
+        }
+        runtime->run(graph);
+
+        vector<Result> results(n);
+        for (auto &output : outputs)
+        {
+            IT_ASSERT(output->getShape()[0] == n,
+                      "Output batch dimension does not match the batch size");
+            vector<uint8_t> stacked(output->getTotalBytes());
+            output->copyToHost(runtime, stacked.data());
+            size_t rowBytes = stacked.size() / n;
+            for (size_t r = 0; r < n; ++r)
+            {
+                auto begin = stacked.begin() + r * rowBytes;
+                results[r][output] = vector<uint8_t>(begin, begin + rowBytes);
+            }
+        }
+        for (size_t r = 0; r < n; ++r)
+        {
+            batch[r].promise.set_value(std::move(results[r]));
+            batch[r].fulfilled = true;
+        }
+    }
+
+} // namespace infini
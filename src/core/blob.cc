@@ -0,0 +1,20 @@
+#include "core/blob.h"
+#include "core/runtime.h"
+
+namespace infini
+{
+  BlobObj::~BlobObj()
+  {
+    if (runtime)
+    {
+      try
+      {
+        runtime->freeAsync(ptr, stream);
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Warning: blob release failed: " << e.what() << std::endl;
+      }
+    }
+  }
+} // namespace infini
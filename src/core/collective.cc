@@ -0,0 +1,97 @@
+#include "core/collective.h"
+
+namespace infini
+{
+    namespace
+    {
+        template <typename T>
+        void accumulate(void *dst, const void *src, size_t count)
+        {
+            auto d = static_cast<T *>(dst);
+            auto s = static_cast<const T *>(src);
+            for (size_t i = 0; i < count; ++i)
+                d[i] += s[i];
+        }
+    } // namespace
+
+    void SharedMemoryCommunicator::Group::barrier()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        uint64_t gen = generation;
+        if (++arrived == worldSize)
+        {
+            arrived = 0;
+            ++generation;
+            cv.notify_all();
+            return;
+        }
+        cv.wait(lock, [&]
+                { return generation != gen; });
+    }
+
+    SharedMemoryCommunicator::SharedMemoryCommunicator(Ref<Group> group, int rank)
+        : group(std::move(group)), rank(rank) {}
+
+    vector<Ref<Communicator>> SharedMemoryCommunicator::createGroup(int worldSize)
+    {
+        IT_ASSERT(worldSize > 0);
+        auto group = make_ref<Group>(worldSize);
+        vector<Ref<Communicator>> comms;
+        for (int rank = 0; rank < worldSize; ++rank)
+            comms.push_back(Ref<Communicator>(new SharedMemoryCommunicator(group, rank)));
+        return comms;
+    }
+
+    int SharedMemoryCommunicator::getRank() const { return rank; }
+
+    int SharedMemoryCommunicator::getWorldSize() const { return group->worldSize; }
+
+    void SharedMemoryCommunicator::allReduceSum(void *data, size_t count, DataType dtype,
+                                                infinirtStream_t stream)
+    {
+        CHECK_INFINI_ERROR(infinirtStreamSynchronize(stream));
+        size_t bytes = count * dtype.getSize();
+        group->buffers[rank] = data;
+        group->barrier();
+        // Every rank sums in the same order, so results are bitwise equal
+        vector<uint8_t> sum(static_cast<const uint8_t *>(group->buffers[0]),
+                            static_cast<const uint8_t *>(group->buffers[0]) + bytes);
+        for (int r = 1; r < group->worldSize; ++r)
+        {
+            const void *src = group->buffers[r];
+            switch (dtype.getType())
+            {
+            case INFINI_DTYPE_F32:
+                accumulate<float>(sum.data(), src, count);
+                break;
+            case INFINI_DTYPE_F64:
+                accumulate<double>(sum.data(), src, count);
+                break;
+            case INFINI_DTYPE_I32:
+                accumulate<int32_t>(sum.data(), src, count);
+                break;
+            case INFINI_DTYPE_I64:
+                accumulate<int64_t>(sum.data(), src, count);
+                break;
+            default:
+                IT_TODO_HALT_MSG("AllReduce of " + dtype.toString());
+            }
+        }
+        // Nobody reads the inputs any more once all ranks passed this point
+        group->barrier();
+        std::memcpy(data, sum.data(), bytes);
+    }
+
+    void SharedMemoryCommunicator::allGather(const void *send, void *recv, size_t bytes,
+                                             infinirtStream_t stream)
+    {
+        CHECK_INFINI_ERROR(infinirtStreamSynchronize(stream));
+        group->buffers[rank] = send;
+        group->barrier();
+        for (int r = 0; r < group->worldSize; ++r)
+            std::memcpy(static_cast<uint8_t *>(recv) + r * bytes, group->buffers[r], bytes);
+        // `send` must stay untouched until every rank copied it
+        group->barrier();
+    }
+
+} // namespace infini
@@ -0,0 +1,73 @@
+#include "core/descriptor_cache.h"
+
+namespace infini
+{
+    DescriptorKey::DescriptorKey(OpType type) { add(type.underlying()); }
+
+    DescriptorKey &DescriptorKey::add(const Tensor &tensor)
+    {
+        auto shape = tensor->getShape();
+        auto stride = tensor->getStride();
+        add(tensor->getDataType().getType());
+        add(shape.size());
+        bytes.append(reinterpret_cast<const char *>(shape.data()),
+                     shape.size() * sizeof(shape[0]));
+        bytes.append(reinterpret_cast<const char *>(stride.data()),
+                     stride.size() * sizeof(stride[0]));
+        return *this;
+    }
+
+    const string &DescriptorKey::str() const { return bytes; }
+
+    Ref<void> DescriptorCache::getOrCreate(const DescriptorKey &key,
+                                           const std::function<Ref<void>()> &create)
+    {
+        auto it = entries.find(key.str());
+        if (it != entries.end())
+        {
+            ++hits;
+            lru.splice(lru.begin(), lru, it->second);
+            return it->second->second;
+        }
+        ++misses;
+        auto desc = create();
+        lru.emplace_front(key.str(), desc);
+        entries.emplace(key.str(), lru.begin());
+        evict();
+        return desc;
+    }
+
+    void DescriptorCache::evict()
+    {
+        while (lru.size() > capacity)
+        {
+            entries.erase(lru.back().first);
+            lru.pop_back();
+            ++evictions;
+        }
+    }
+
+    void DescriptorCache::clear()
+    {
+        entries.clear();
+        lru.clear();
+    }
+
+    void DescriptorCache::setCapacity(size_t capacity_)
+    {
+        IT_ASSERT(capacity_ > 0);
+        capacity = capacity_;
+        evict();
+    }
+
+    size_t DescriptorCache::getCapacity() const { return capacity; }
+
+    size_t DescriptorCache::size() const { return entries.size(); }
+
+    size_t DescriptorCache::getHits() const { return hits; }
+
+    size_t DescriptorCache::getMisses() const { return misses; }
+
+    size_t DescriptorCache::getEvictions() const { return evictions; }
+
+} // namespace infini
@@ -0,0 +1,54 @@
+#include "core/execution_plan.h"
+
+namespace infini
+{
+    namespace
+    {
+        const Tensor &recordTensor(const LaunchRecord &record, size_t idx)
+        {
+            return idx < record.numOutputs ? record.op->getOutputs()[idx]
+                                           : record.op->getInputs()[idx - record.numOutputs];
+        }
+    } // namespace
+
+    void ExecutionPlan::fillData(LaunchRecord &record)
+    {
+        const auto &outputs = record.op->getOutputs();
+        const auto &inputs = record.op->getInputs();
+        IT_ASSERT(outputs.size() + inputs.size() <= LaunchRecord::kMaxArgs,
+                  "Too many tensors for a launch record");
+        record.numOutputs = outputs.size();
+        record.numInputs = inputs.size();
+        for (size_t idx = 0; idx < outputs.size() + inputs.size(); ++idx)
+        {
+            auto &tensor = recordTensor(record, idx);
+            record.blobs[idx] = tensor->getData();
+            record.data[idx] = tensor->getData() ? tensor->getRawDataPtr<void *>() : nullptr;
+        }
+    }
+
+    bool ExecutionPlan::isStale(const LaunchRecord &record)
+    {
+        for (size_t idx = 0; idx < record.numOutputs + record.numInputs; ++idx)
+        {
+            if (recordTensor(record, idx)->getData() != record.blobs[idx])
+                return true;
+        }
+        return false;
+    }
+
+    bool ExecutionPlan::refreshStaleData()
+    {
+        bool stale = false;
+        for (auto &record : records)
+        {
+            if (isStale(record))
+            {
+                fillData(record);
+                stale = true;
+            }
+        }
+        return stale;
+    }
+
+} // namespace infini
@@ -1,4 +1,5 @@
 #include "core/graph.h"
+#include "core/runtime.h"
 
 namespace infini
 {
@@ -57,6 +58,26 @@ namespace infini
 
     void GraphObj::removeOperator(Operator op)
     {
+        plan = nullptr;
+        planCache.clear();
+        workspaceSize.reset();
+        streamAssignment.erase(op.get());
+        for (auto &input : op->getInputs())
+        {
+            if (input)
+                input->removeTarget(op);
+        }
+        for (auto &output : op->getOutputs())
+        {
+            if (output && output->getSource() == op)
+                output->setSource(nullptr);
+        }
+        for (auto &pred : op->getPredecessors())
+            pred->removeSuccessors(op);
+        for (auto &succ : op->getSuccessors())
+            succ->removePredecessors(op);
+        op->predecessors.clear();
+        op->successors.clear();
         auto it = std::find(ops.begin(), ops.end(), op);
         if (it != ops.end())
             ops.erase(it);
@@ -64,11 +85,58 @@ namespace infini
 
     void GraphObj::removeTensor(Tensor tensor)
     {
+        planCache.clear();
         auto it = std::find(tensors.begin(), tensors.end(), tensor);
         if (it != tensors.end())
             tensors.erase(it);
     }
 
+    void GraphObj::replaceAllUses(const Tensor &from, const Tensor &to)
+    {
+        if (from == to)
+            return;
+        plan = nullptr;
+        planCache.clear();
+        auto source = from->getSource();
+        auto newSource = to->getSource();
+        for (auto &op : from->getTargets())
+        {
+            op->replaceInput(from, to);
+            from->removeTarget(op);
+            to->addTarget(op);
+            // The op may still read another output of the old source
+            auto &inputs = op->getInputs();
+            if (source && std::none_of(inputs.begin(), inputs.end(), [&](const Tensor &input)
+                                       { return input && input->getSource() == source; }))
+            {
+                op->removePredecessors(source);
+                source->removeSuccessors(op);
+            }
+            if (newSource)
+            {
+                op->addPredecessors(newSource);
+                newSource->addSuccessors(op);
+            }
+        }
+    }
+
+    void GraphObj::setOutputs(TensorVec outputs_)
+    {
+        for (auto &output : outputs_)
+        {
+            IT_ASSERT(std::find(tensors.begin(), tensors.end(), output) != tensors.end(),
+                      "Graph output is not in graph");
+        }
+        outputs = std::move(outputs_);
+    }
+
+    const TensorVec &GraphObj::getOutputs() const { return outputs; }
+
+    bool GraphObj::isOutput(const Tensor &tensor) const
+    {
+        return std::find(outputs.begin(), outputs.end(), tensor) != outputs.end();
+    }
+
     const TensorVec &GraphObj::getTensors() const { return tensors; }
 
     const OpVec &GraphObj::getOperators() const { return ops; }
@@ -87,6 +155,7 @@ namespace infini
 
     bool GraphObj::topo_sort()
     {
+        plan = nullptr;
         std::unordered_map<OperatorObj *, int> indegree;
         for (auto &op : ops)
         {
@@ -103,19 +172,23 @@ namespace infini
             }
         }
 
-        std::queue<Operator> q;
+        // Always take the earliest ready op, so a sorted list stays as is
+        std::unordered_map<OperatorObj *, size_t> position;
+        for (size_t i = 0; i < ops.size(); ++i)
+            position[ops[i].get()] = i;
+        std::priority_queue<size_t, vector<size_t>, std::greater<size_t>> q;
         for (auto &op : ops)
         {
             if (indegree[op.get()] == 0)
             {
-                q.push(op);
+                q.push(position[op.get()]);
             }
         }
 
         std::vector<Operator> sorted;
         while (!q.empty())
         {
-            auto op = q.front();
+            auto op = ops[q.top()];
             q.pop();
             sorted.push_back(op);
 
@@ -123,7 +196,7 @@ namespace infini
             {
                 if (--indegree[succ.get()] == 0)
                 {
-                    q.push(succ);
+                    q.push(position[succ.get()]);
                 }
             }
         }
@@ -140,37 +213,330 @@ namespace infini
     // !
     void GraphObj::shape_infer()
     {
+        workspaceSize.reset();
+        plan = nullptr;
         for (auto &op : ops)
         {
             auto ans = op->inferShape();
             IT_ASSERT(ans.has_value());
-            auto oldOutputs = op->getOutputs();
+            const auto &oldOutputs = op->getOutputs();
             IT_ASSERT(ans.value().size() == oldOutputs.size());
             // replace the old outputshape and size with new one
-            for (int i = 0; i < (int)ans.value().size(); ++i)
+            for (size_t i = 0; i < ans.value().size(); ++i)
             {
-                auto newShape = ans.value()[i];
-                auto oldShape = oldOutputs[i]->getShape();
-                auto fuid = oldOutputs[i]->getFuid();
-                if (newShape != oldShape)
-                {
-                    auto tensor = this->getTensor(fuid);
-                    tensor->setShape(newShape);
-                }
+                if (ans.value()[i] != oldOutputs[i]->getShape())
+                    oldOutputs[i]->setShape(ans.value()[i]);
+            }
+        }
+        // Ops whose tensors changed get a new descriptor and kernel choice
+        // on their next run
+        for (auto &op : ops)
+        {
+            if (op->opDesc ? op->getDescKey().str() != op->descKey : op->kernel != nullptr)
+                op->resetOpDesc();
+        }
+    }
+
+    size_t GraphObj::shape_infer(const TensorVec &changed)
+    {
+        workspaceSize.reset();
+        plan = nullptr;
+        std::unordered_set<OperatorObj *> dirty;
+        for (auto &tensor : changed)
+        {
+            for (auto &target : tensor->getTargets())
+                dirty.insert(target.get());
+        }
+        size_t numInferred = 0;
+        for (auto &op : ops)
+        {
+            if (dirty.empty())
+                break;
+            if (!dirty.erase(op.get()))
+                continue;
+            ++numInferred;
+            auto ans = op->inferShape();
+            IT_ASSERT(ans.has_value());
+            const auto &outputs = op->getOutputs();
+            IT_ASSERT(ans.value().size() == outputs.size());
+            for (size_t i = 0; i < outputs.size(); ++i)
+            {
+                if (ans.value()[i] == outputs[i]->getShape())
+                    continue;
+                outputs[i]->setShape(ans.value()[i]);
+                for (auto &target : outputs[i]->getTargets())
+                    dirty.insert(target.get());
             }
+            if (op->opDesc ? op->getDescKey().str() != op->descKey : op->kernel != nullptr)
+                op->resetOpDesc();
+        }
+        return numInferred;
+    }
+
+    TensorVec GraphObj::getSourceTensors() const
+    {
+        TensorVec result;
+        for (auto &tensor : tensors)
+        {
+            if (!tensor->getSource())
+                result.push_back(tensor);
+        }
+        return result;
+    }
+
+    PreparedShape GraphObj::capturePrepared() const
+    {
+        PreparedShape prepared;
+        for (auto &tensor : tensors)
+            prepared.tensors[tensor.get()] = {tensor->shape, tensor->stride, tensor->data};
+        for (auto &op : ops)
+        {
+            prepared.ops[op.get()] = {op->opDesc, op->infiniOpDesc, op->descKey,
+                                      op->descHandle, op->kernel, op->kernelDevice,
+                                      op->kernelEpoch};
+        }
+        prepared.memoryPlan = memoryPlan;
+        prepared.arena = arena;
+        prepared.workspaceSize = workspaceSize;
+        prepared.offloader = offloader;
+        prepared.plan = plan;
+        return prepared;
+    }
+
+    void GraphObj::restorePrepared(const PreparedShape &prepared, const TensorVec &resized)
+    {
+        for (auto &tensor : tensors)
+        {
+            // Only activations and the inputs that change size belong to the
+            // entry; weights and other inputs keep their current storage
+            if (!tensor->getSource()
+                    ? std::find(resized.begin(), resized.end(), tensor) == resized.end()
+                    : tensor->isWeight())
+                continue;
+            auto it = prepared.tensors.find(tensor.get());
+            if (it == prepared.tensors.end())
+                continue;
+            const auto &state = it->second;
+            tensor->shape = state.shape;
+            tensor->stride = state.stride;
+            tensor->data = state.data;
+        }
+        for (auto &op : ops)
+        {
+            const auto &state = prepared.ops.at(op.get());
+            op->opDesc = state.opDesc;
+            op->infiniOpDesc = state.infiniOpDesc;
+            op->descKey = state.descKey;
+            op->descHandle = state.descHandle;
+            op->kernel = state.kernel;
+            op->kernelDevice = state.kernelDevice;
+            op->kernelEpoch = state.kernelEpoch;
         }
+        memoryPlan = prepared.memoryPlan;
+        arena = prepared.arena;
+        workspaceSize = prepared.workspaceSize;
+        offloader = prepared.offloader;
+        plan = prepared.plan;
     }
 
+    void GraphObj::setInputShapes(const std::map<Tensor, Shape> &shapes)
+    {
+        auto inputs = getSourceTensors();
+        bool allocated = std::any_of(tensors.begin(), tensors.end(),
+                                     [](const Tensor &t)
+                                     { return t->data != nullptr; });
+        // Weights are shared by all entries, only activations differ
+        if (allocated)
+            planCache.insert(PlanCache::key(inputs), capturePrepared());
+
+        TensorVec changed;
+        for (auto &[tensor, shape] : shapes)
+        {
+            IT_ASSERT(!tensor->getSource(), "Only graph inputs can be reshaped");
+            if (tensor->getShape() == shape)
+                continue;
+            tensor->setShape(shape);
+            changed.push_back(tensor);
+        }
+        if (changed.empty())
+            return;
+        if (auto prepared = planCache.find(PlanCache::key(inputs)))
+        {
+            restorePrepared(*prepared, changed);
+            return;
+        }
+
+        shape_infer(changed);
+        if (!allocated)
+            return;
+        // The cached entry keeps the old buffers, new ones are planned below
+        std::unordered_set<TensorObj *> resized;
+        for (auto &tensor : changed)
+            resized.insert(tensor.get());
+        for (auto &tensor : tensors)
+        {
+            if (tensor->data && !tensor->data->isExternal() &&
+                (tensor->getSource() || resized.count(tensor.get())))
+                tensor->data = nullptr;
+        }
+        arena = nullptr;
+        dataMalloc();
+    }
+
+    PlanCache &GraphObj::getPlanCache() { return planCache; }
+
     void GraphObj::dataMalloc()
     {
+        IT_ASSERT(topo_sort() == true, "Graph has a cycle");
+        // Tensors placed in the previous arena are planned again, unless a
+        // rewrite turned them into constants with storage of their own
+        for (auto &tensor : tensors)
+        {
+            if (memoryPlan.isPlanned(tensor) && tensor->getSource())
+                tensor->data = nullptr;
+        }
+        vector<int> streamOf;
+        if (!streamAssignment.empty())
+        {
+            for (auto &op : ops)
+            {
+                auto it = streamAssignment.find(op.get());
+                streamOf.push_back(it == streamAssignment.end() ? -1 : it->second);
+            }
+        }
+        memoryPlan = MemoryPlanner::plan(ops, tensors, streamOf, outputs);
+        if (memoryPlan.arenaSize > 0)
+        {
+            arena = make_ref<BlobObj>(runtime,
+                                      runtime->allocDevice(memoryPlan.arenaSize),
+                                      runtime->getCurrentStream());
+        }
+        size_t budget = runtime->getMemoryBudget();
+        TensorVec offloaded;
         for (auto &tensor : tensors)
         {
-            tensor->dataMalloc(runtime);
+            if (tensor->data != nullptr)
+                continue;
+            if (memoryPlan.isPlanned(tensor))
+            {
+                tensor->data = make_ref<BlobObj>(arena, memoryPlan.getOffset(tensor));
+            }
+            else if (budget > 0)
+            {
+                offloaded.push_back(tensor);
+            }
+            else
+            {
+                tensor->dataMalloc(runtime);
+            }
+        }
+        offloader = nullptr;
+        if (!offloaded.empty())
+        {
+            size_t fixedBytes = memoryPlan.arenaSize + getWorkspaceSize();
+            offloader = make_ref<OffloadManager>(runtime, budget, fixedBytes, ops,
+                                                 offloaded);
+        }
+    }
+
+    const MemoryPlan &GraphObj::getMemoryPlan() const { return memoryPlan; }
+
+    Ref<OffloadManager> GraphObj::getOffloader() const { return offloader; }
+
+    Ref<ExecutionPlan> GraphObj::getPlan() const { return plan; }
+
+    void GraphObj::setStreamAssignment(std::unordered_map<OperatorObj *, int> assignment)
+    {
+        streamAssignment = std::move(assignment);
+    }
+
+    const std::unordered_map<OperatorObj *, int> &GraphObj::getStreamAssignment() const
+    {
+        return streamAssignment;
+    }
+
+    void GraphObj::setPlan(Ref<ExecutionPlan> plan_) { plan = std::move(plan_); }
+
+    Ref<AsyncRunPool> GraphObj::getAsyncPool() const { return asyncPool; }
+
+    void GraphObj::setAsyncPool(Ref<AsyncRunPool> pool) { asyncPool = std::move(pool); }
+
+    size_t GraphObj::getWorkspaceSize()
+    {
+        if (!workspaceSize)
+        {
+            size_t size = 0;
+            for (auto &op : ops)
+                size = std::max(size, op->getWorkspaceSize(runtime.get()));
+            workspaceSize = size;
+        }
+        return *workspaceSize;
+    }
+
+    void GraphObj::addOperator(const Operator &op) { addOperatorAndConnect(op); }
+
+    const PassReport &GraphObj::optimize(const PassManager &passes)
+    {
+        bool allocated = std::any_of(tensors.begin(), tensors.end(),
+                                     [](const Tensor &tensor)
+                                     { return tensor->getData() != nullptr; });
+        passReport = passes.run(*this);
+        if (passReport.changed())
+        {
+            // Passes append the ops they create
+            IT_ASSERT(topo_sort(), "Graph has a cycle");
+            plan = nullptr;
+            workspaceSize.reset();
+            if (allocated)
+                dataMalloc();
+        }
+        return passReport;
+    }
+
+    void GraphObj::optimize(OptLevel level)
+    {
+        if (level <= optLevel)
+            return;
+        optimize(PassManager::create(level));
+        optLevel = level;
+    }
+
+    OptLevel GraphObj::getOptLevel() const { return optLevel; }
+
+    const PassReport &GraphObj::getPassReport() const { return passReport; }
+
+    Graph GraphObj::extractSubgraph(const OpVec &subOps,
+                                    std::unordered_map<TensorObj *, Tensor> &tensorMap) const
+    {
+        Graph graph = make_ref<GraphObj>(runtime);
+        auto copy = [&](const Tensor &tensor)
+        {
+            auto it = tensorMap.find(tensor.get());
+            if (it != tensorMap.end())
+                return it->second;
+            auto result = graph->addTensor(tensor->getShape(), tensor->getDataType());
+            result->setStride(tensor->getStride());
+            result->setWeight(tensor->isWeight());
+            if (!tensor->getSource() && tensor->getData())
+                result->attachBlob(tensor->getData());
+            return tensorMap[tensor.get()] = result;
+        };
+        for (auto &op : subOps)
+        {
+            TensorVec inputs, outputs;
+            for (auto &input : op->getInputs())
+                inputs.push_back(copy(input));
+            for (auto &output : op->getOutputs())
+                outputs.push_back(copy(output));
+            graph->addOperator(op->clone(inputs, outputs));
         }
+        return graph;
     }
 
     void GraphObj::addOperatorAndConnect(const Operator &op)
     {
+        plan = nullptr;
+        planCache.clear();
         ops.push_back(op);
         for (auto &input : op->getInputs())
         {
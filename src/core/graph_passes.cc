@@ -0,0 +1,242 @@
+#include "core/graph_passes.h"
+#include "core/runtime.h"
+#include "operators/Gemm.h"
+#include "operators/Transpose.h"
+
+namespace infini
+{
+    bool PruneDanglingTensorsPass::run(GraphObj &graph)
+    {
+        TensorVec dangling;
+        for (auto &tensor : graph.getTensors())
+        {
+            if (!tensor->getSource() && tensor->getTargets().empty() &&
+                !graph.isOutput(tensor))
+                dangling.push_back(tensor);
+        }
+        for (auto &tensor : dangling)
+            graph.removeTensor(tensor);
+        return !dangling.empty();
+    }
+
+    bool EliminateDeadCodePass::run(GraphObj &graph)
+    {
+        const auto &outputs = graph.getOutputs();
+        if (outputs.empty())
+            return false;
+        std::unordered_set<OperatorObj *> live;
+        std::unordered_set<TensorObj *> used;
+        vector<Tensor> stack(outputs.begin(), outputs.end());
+        while (!stack.empty())
+        {
+            auto tensor = stack.back();
+            stack.pop_back();
+            if (!used.insert(tensor.get()).second)
+                continue;
+            auto source = tensor->getSource();
+            if (!source || !live.insert(source.get()).second)
+                continue;
+            // A live op writes all of its outputs, read or not
+            for (auto &output : source->getOutputs())
+                used.insert(output.get());
+            for (auto &input : source->getInputs())
+                stack.push_back(input);
+        }
+
+        OpVec dead;
+        for (auto &op : graph.getOperators())
+        {
+            if (!live.count(op.get()))
+                dead.push_back(op);
+        }
+        for (auto &op : dead)
+            graph.removeOperator(op);
+        TensorVec unused;
+        for (auto &tensor : graph.getTensors())
+        {
+            if (!used.count(tensor.get()))
+                unused.push_back(tensor);
+        }
+        for (auto &tensor : unused)
+            graph.removeTensor(tensor);
+        return !dead.empty() || !unused.empty();
+    }
+
+    bool EliminateCommonSubexpressionsPass::run(GraphObj &graph)
+    {
+        IT_ASSERT(graph.topo_sort(), "Graph has a cycle");
+        // Inputs of an op are final once it is visited, so merging one op
+        // lets its readers match in turn
+        std::unordered_map<string, Operator> seen;
+        OpVec duplicates;
+        OpVec ops = graph.getOperators();
+        for (auto &op : ops)
+        {
+            DescriptorKey key(op->getOpType());
+            if (!op->addAttrs(key))
+                continue;
+            for (auto &input : op->getInputs())
+                key.add(reinterpret_cast<uintptr_t>(input.get()));
+            auto [it, inserted] = seen.emplace(key.str(), op);
+            // Callers hold on to declared outputs, which must stay computed
+            const auto &opOutputs = op->getOutputs();
+            if (inserted || std::any_of(opOutputs.begin(), opOutputs.end(),
+                                        [&](const Tensor &output)
+                                        { return graph.isOutput(output); }))
+                continue;
+            for (size_t i = 0; i < opOutputs.size(); ++i)
+                graph.replaceAllUses(opOutputs[i], it->second->getOutput(i));
+            duplicates.push_back(op);
+        }
+        for (auto &op : duplicates)
+        {
+            graph.removeOperator(op);
+            for (auto &output : op->getOutputs())
+                graph.removeTensor(output);
+        }
+        return !duplicates.empty();
+    }
+
+    bool AbsorbTransposePass::run(GraphObj &graph)
+    {
+        bool changed = false;
+        OpVec ops = graph.getOperators();
+        for (auto &op : ops)
+        {
+            if (op->getOpType() != OpType::Transpose ||
+                !as<TransposeObj>(op)->swapsLastTwoDims())
+                continue;
+            auto input = op->getInput(0), output = op->getOutput(0);
+            for (auto &target : output->getTargets())
+            {
+                if (target->getOpType() != OpType::Gemm)
+                    continue;
+                auto gemm = as<GemmObj>(target);
+                // The bias is broadcast by its own strides; leave it alone
+                auto bias = gemm->getBias();
+                if (bias == output)
+                    continue;
+                auto A = gemm->getInput(0), B = gemm->getInput(1);
+                bool transA = gemm->getTransA(), transB = gemm->getTransB();
+                if (A == output)
+                {
+                    A = input;
+                    transA = !transA;
+                }
+                if (B == output)
+                {
+                    B = input;
+                    transB = !transB;
+                }
+                graph.removeOperator(gemm);
+                graph.addOperator(make_ref<GemmObj>(
+                    Unchecked{}, A, B, gemm->getOutput(0), bias, gemm->getAlpha(),
+                    gemm->getBeta(), transA, transB, gemm->getActivation()));
+                changed = true;
+            }
+            if (output->getTargets().empty() && !graph.isOutput(output))
+            {
+                graph.removeOperator(op);
+                graph.removeTensor(output);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    bool FuseGemmActivationPass::run(GraphObj &graph)
+    {
+        bool changed = false;
+        OpVec ops = graph.getOperators();
+        for (auto &op : ops)
+        {
+            if (op->getOpType() != OpType::Gemm)
+                continue;
+            auto gemm = as<GemmObj>(op);
+            auto output = gemm->getOutput(0);
+            auto targets = output->getTargets();
+            if (gemm->getActivation().type != ActType::None || targets.size() != 1 ||
+                graph.isOutput(output))
+                continue;
+            // Without a bias beta scales the previous content of the output,
+            // which the fused op would take from the activation's output
+            if (gemm->getBeta() != 0.0f && !gemm->getBias())
+                continue;
+            auto act = targets.front();
+            if (act->getOpType() != OpType::Relu && act->getOpType() != OpType::Clip)
+                continue;
+            auto result = act->getOutput(0);
+            graph.removeOperator(act);
+            graph.removeOperator(gemm);
+            graph.removeTensor(output);
+            auto fused = as<GemmObj>(gemm->clone(gemm->getInputs(), {result}));
+            fused->setActivation(getActivation(act));
+            graph.addOperator(fused);
+            changed = true;
+        }
+        return changed;
+    }
+
+
+    bool FoldConstantsPass::run(GraphObj &graph)
+    {
+        // Weights of an offloaded graph may not be on the device
+        if (graph.getOffloader())
+            return false;
+        IT_ASSERT(graph.topo_sort(), "Graph has a cycle");
+        auto runtime = graph.getRuntime();
+        auto device = runtime->getCurrentThreadContext()->device;
+        auto isConstant = [](const Tensor &tensor)
+        {
+            return !tensor->getSource() && tensor->isWeight() && tensor->getData();
+        };
+        OpVec folded;
+        TensorVec inputs;
+        OpVec ops = graph.getOperators();
+        for (auto &op : ops)
+        {
+            auto type = op->getOpType();
+            DescriptorKey attrs(type);
+            // Only ops computing their outputs from inputs and attributes alone
+            // fold; collectives have to run on every rank together
+            if (type == OpType::AllReduceSum || type == OpType::AllGather ||
+                !op->addAttrs(attrs) || op->getInputs().empty() ||
+                !std::all_of(op->getInputs().begin(), op->getInputs().end(), isConstant))
+                continue;
+            const Kernel *kernel = nullptr;
+            for (auto &item : KernelRegistry::getInstance().getKernelItems({device, type.underlying()}))
+            {
+                if (std::get<0>(item)->isApplicable(op))
+                {
+                    kernel = std::get<0>(item);
+                    break;
+                }
+            }
+            if (!kernel)
+                continue;
+            // Outputs get their own storage: an arena slot would be reused
+            for (auto &output : op->getOutputs())
+            {
+                output->attachBlob(make_ref<BlobObj>(
+                    runtime, runtime->allocDevice(output->getTotalBytes()),
+                    runtime->getCurrentStream()));
+            }
+            kernel->compute(op, runtime.get());
+            graph.removeOperator(op);
+            for (auto &output : op->getOutputs())
+                output->setWeight(true);
+            inputs.insert(inputs.end(), op->getInputs().begin(), op->getInputs().end());
+            folded.push_back(op);
+        }
+        if (folded.empty())
+            return false;
+        runtime->streamSynchronize(runtime->getCurrentStream());
+        for (auto &input : inputs)
+        {
+            if (input->getTargets().empty() && !input->getSource())
+                graph.removeTensor(input);
+        }
+        return true;
+    }
+
+} // namespace infini
@@ -0,0 +1,335 @@
+#include "core/graph_serializer.h"
+#include "core/runtime.h"
+#include "operators/Activation.h"
+#include "operators/Gemm.h"
+#include "operators/RMSNorm.h"
+#include "operators/Transpose.h"
+#include "utils/mapped_file.h"
+
+namespace infini
+{
+    namespace
+    {
+        template <typename T>
+        void write(std::ostream &os, const T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        class Reader
+        {
+            const char *cur;
+            const char *end;
+
+        public:
+            Reader(const char *data, size_t size) : cur(data), end(data + size) {}
+
+            template <typename T>
+            T read()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                IT_ASSERT(sizeof(T) <= size_t(end - cur), "Truncated graph file");
+                T value;
+                std::memcpy(&value, cur, sizeof(T));
+                cur += sizeof(T);
+                return value;
+            }
+
+            const char *skip(size_t bytes)
+            {
+                IT_ASSERT(bytes <= size_t(end - cur), "Truncated graph file");
+                const char *ptr = cur;
+                cur += bytes;
+                return ptr;
+            }
+        };
+    } // namespace
+
+    void GraphSerializer::writeAttributes(const Operator &op, std::ostream &os)
+    {
+        switch (op->getOpType().underlying())
+        {
+        case OpType::Gemm:
+        {
+            auto gemm = as<GemmObj>(op);
+            write(os, gemm->getAlpha());
+            write(os, gemm->getBeta());
+            write(os, uint8_t(gemm->getTransA()));
+            write(os, uint8_t(gemm->getTransB()));
+            auto &act = gemm->getActivation();
+            write(os, uint8_t(act.type));
+            write(os, act.min);
+            write(os, act.max);
+            break;
+        }
+        case OpType::RMSNorm:
+            write(os, as<RMSNormObj>(op)->getEpsilon());
+            break;
+        case OpType::Relu:
+            break;
+        case OpType::Clip:
+        {
+            auto clip = as<ClipObj>(op);
+            write(os, clip->getMin());
+            write(os, clip->getMax());
+            break;
+        }
+        case OpType::Transpose:
+        {
+            auto &perm = as<TransposeObj>(op)->getPerm();
+            write(os, uint8_t(perm.size()));
+            for (int dim : perm)
+                write(os, int32_t(dim));
+            break;
+        }
+        default:
+            IT_TODO_HALT_MSG(string("Serialization of ") + op->getOpType().toString());
+        }
+    }
+
+    Operator GraphSerializer::createOperator(uint32_t version, OpType type,
+                                             const TensorVec &inputs,
+                                             const TensorVec &outputs,
+                                             const char *attrs, size_t attrBytes)
+    {
+        Reader reader(attrs, attrBytes);
+        switch (type.underlying())
+        {
+        case OpType::Gemm:
+        {
+            IT_ASSERT((inputs.size() == 2 || inputs.size() == 3) && outputs.size() == 1);
+            auto alpha = reader.read<float>();
+            auto beta = reader.read<float>();
+            auto transA = reader.read<uint8_t>() != 0;
+            auto transB = reader.read<uint8_t>() != 0;
+            // Version 1 has no activation
+            Activation act;
+            if (version >= 2)
+            {
+                act.type = ActType(reader.read<uint8_t>());
+                act.min = reader.read<float>();
+                act.max = reader.read<float>();
+            }
+            return make_ref<GemmObj>(Unchecked{}, inputs[0], inputs[1], outputs[0],
+                                     inputs.size() == 3 ? inputs[2] : nullptr, alpha,
+                                     beta, transA, transB, act);
+        }
+        case OpType::RMSNorm:
+        {
+            IT_ASSERT(inputs.size() == 2 && outputs.size() == 1);
+            auto epsilon = reader.read<float>();
+            return make_ref<RMSNormObj>(Unchecked{}, inputs[0], outputs[0], inputs[1],
+                                        epsilon);
+        }
+        case OpType::Relu:
+        {
+            IT_ASSERT(inputs.size() == 1 && outputs.size() == 1);
+            return make_ref<ReluObj>(Unchecked{}, inputs[0], outputs[0]);
+        }
+        case OpType::Clip:
+        {
+            IT_ASSERT(inputs.size() == 1 && outputs.size() == 1);
+            auto min = reader.read<float>();
+            auto max = reader.read<float>();
+            return make_ref<ClipObj>(Unchecked{}, inputs[0], outputs[0], min, max);
+        }
+        case OpType::Transpose:
+        {
+            IT_ASSERT(inputs.size() == 1 && outputs.size() == 1);
+            vector<int> perm(reader.read<uint8_t>());
+            for (auto &dim : perm)
+                dim = reader.read<int32_t>();
+            return make_ref<TransposeObj>(Unchecked{}, inputs[0], outputs[0], perm);
+        }
+        default:
+            IT_TODO_HALT_MSG(string("Deserialization of ") + type.toString());
+        }
+        return nullptr;
+    }
+
+    void GraphSerializer::save(const Graph &graph, const string &path, bool withWeights)
+    {
+        auto runtime = graph->getRuntime();
+        const auto &tensors = graph->getTensors();
+        const auto &ops = graph->getOperators();
+
+        // Views are stored with their elements only, as contiguous tensors
+        auto storedBytes = [](const Tensor &tensor) -> size_t
+        {
+            return tensor->isContiguous()
+                       ? tensor->getTotalBytes()
+                       : tensor->getElement() * tensor->getDataType().getSize();
+        };
+
+        // Lay out the data section first so tensor records can point into it
+        vector<uint64_t> offsets(tensors.size(), kNoData);
+        uint64_t dataSize = 0;
+        for (size_t i = 0; i < tensors.size(); ++i)
+        {
+            auto &tensor = tensors[i];
+            if (withWeights && !tensor->getSource() && tensor->getData())
+            {
+                offsets[i] = dataSize;
+                dataSize += (storedBytes(tensor) + kDataAlignment - 1) /
+                            kDataAlignment * kDataAlignment;
+            }
+        }
+        auto storedStride = [&](size_t i)
+        {
+            auto &tensor = tensors[i];
+            if (offsets[i] == kNoData || tensor->isContiguous())
+                return tensor->getStride();
+            auto shape = tensor->getShape();
+            Stride stride(shape.size());
+            StrideElem st = 1;
+            for (size_t d = shape.size(); d > 0; --d)
+            {
+                stride[d - 1] = st;
+                st *= shape[d - 1];
+            }
+            return stride;
+        };
+
+        std::ostringstream meta(std::ios::binary);
+        for (size_t i = 0; i < tensors.size(); ++i)
+        {
+            auto &tensor = tensors[i];
+            auto shape = tensor->getShape();
+            auto stride = storedStride(i);
+            write(meta, int32_t(tensor->getFuid()));
+            write(meta, int32_t(tensor->getDataType().getType()));
+            write(meta, uint32_t(shape.size()));
+            for (auto dim : shape)
+                write(meta, uint64_t(dim));
+            for (auto st : stride)
+                write(meta, int64_t(st));
+            write(meta, offsets[i]);
+            write(meta, uint64_t(offsets[i] == kNoData ? 0 : storedBytes(tensor)));
+        }
+        for (auto &op : ops)
+        {
+            write(meta, op->getOpType().underlying());
+            write(meta, uint32_t(op->getNumInputs()));
+            write(meta, uint32_t(op->getNumOutputs()));
+            for (auto &input : op->getInputs())
+                write(meta, int32_t(input->getFuid()));
+            for (auto &output : op->getOutputs())
+                write(meta, int32_t(output->getFuid()));
+            std::ostringstream attrs(std::ios::binary);
+            writeAttributes(op, attrs);
+            auto attrStr = attrs.str();
+            write(meta, uint32_t(attrStr.size()));
+            meta << attrStr;
+        }
+
+        auto metaStr = meta.str();
+        constexpr size_t headerSize = 8 + 4 + 4 + 8 + 8 + 8;
+        uint64_t dataOffset = (headerSize + metaStr.size() + kDataAlignment - 1) /
+                              kDataAlignment * kDataAlignment;
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        IT_ASSERT(out.good(), "Cannot open " + path);
+        out.write(kMagic, sizeof(kMagic));
+        write(out, kVersion);
+        write(out, uint32_t(0));
+        write(out, uint64_t(tensors.size()));
+        write(out, uint64_t(ops.size()));
+        write(out, dataOffset);
+        out << metaStr;
+        out << string(dataOffset - headerSize - metaStr.size(), '\0');
+
+        vector<char> buffer;
+        for (size_t i = 0; i < tensors.size(); ++i)
+        {
+            if (offsets[i] == kNoData)
+                continue;
+            auto &tensor = tensors[i];
+            size_t bytes = storedBytes(tensor);
+            buffer.resize((bytes + kDataAlignment - 1) / kDataAlignment * kDataAlignment);
+            std::fill(buffer.begin() + bytes, buffer.end(), 0);
+            tensor->copyToHost(runtime, buffer.data());
+            out.write(buffer.data(), buffer.size());
+        }
+        IT_ASSERT(out.good(), "Failed writing " + path);
+    }
+
+    Graph GraphSerializer::load(const Runtime &runtime, const string &path)
+    {
+        auto file = std::make_shared<MappedFile>(path);
+        Reader reader(file->data(), file->size());
+        IT_ASSERT(std::memcmp(reader.skip(sizeof(kMagic)), kMagic, sizeof(kMagic)) == 0,
+                  path + " is not a serialized graph");
+        auto version = reader.read<uint32_t>();
+        IT_ASSERT(version >= kMinVersion && version <= kVersion,
+                  "Unsupported graph file version " + std::to_string(version));
+        reader.read<uint32_t>(); // flags
+        auto numTensors = reader.read<uint64_t>();
+        auto numOps = reader.read<uint64_t>();
+        auto dataOffset = reader.read<uint64_t>();
+        IT_ASSERT(dataOffset <= file->size(), "Truncated graph file");
+        char *data = file->data() + dataOffset;
+        size_t dataSize = file->size() - dataOffset;
+
+        bool zeroCopy = runtime->getCurrentThreadContext()->device == INFINI_DEVICE_CPU;
+        Graph graph = make_ref<GraphObj>(runtime);
+        graph->tensors.reserve(numTensors);
+        graph->ops.reserve(numOps);
+        std::unordered_map<int32_t, Tensor> byFuid;
+        for (uint64_t i = 0; i < numTensors; ++i)
+        {
+            auto fuid = reader.read<int32_t>();
+            DataType dtype(static_cast<infiniDtype_t>(reader.read<int32_t>()));
+            auto rank = reader.read<uint32_t>();
+            Shape shape(rank);
+            Stride stride(rank);
+            for (auto &dim : shape)
+                dim = reader.read<uint64_t>();
+            for (auto &st : stride)
+                st = reader.read<int64_t>();
+            auto offset = reader.read<uint64_t>();
+            auto bytes = reader.read<uint64_t>();
+
+            auto tensor = graph->addTensor(make_ref<TensorObj>(shape, stride, dtype));
+            byFuid[fuid] = tensor;
+            if (offset == kNoData)
+                continue;
+            IT_ASSERT(offset <= dataSize && bytes <= dataSize - offset &&
+                          bytes == tensor->getTotalBytes(),
+                      "Bad inline data for tensor " + std::to_string(fuid));
+            if (zeroCopy)
+            {
+                tensor->attachBlob(make_ref<BlobObj>(data + offset, file, MemoryLocation::Host));
+            }
+            else
+            {
+                tensor->dataMalloc(runtime);
+                tensor->copyFromHost(runtime, data + offset);
+            }
+        }
+
+        auto lookup = [&](int32_t fuid)
+        {
+            auto it = byFuid.find(fuid);
+            IT_ASSERT(it != byFuid.end(), "Unknown tensor fuid " + std::to_string(fuid));
+            return it->second;
+        };
+        for (uint64_t i = 0; i < numOps; ++i)
+        {
+            OpType type(reader.read<OpType::underlying_t>());
+            auto numInputs = reader.read<uint32_t>();
+            auto numOutputs = reader.read<uint32_t>();
+            TensorVec inputs, outputs;
+            for (uint32_t j = 0; j < numInputs; ++j)
+                inputs.push_back(lookup(reader.read<int32_t>()));
+            for (uint32_t j = 0; j < numOutputs; ++j)
+                outputs.push_back(lookup(reader.read<int32_t>()));
+            auto attrBytes = reader.read<uint32_t>();
+            const char *attrs = reader.skip(attrBytes);
+            graph->addOperatorAndConnect(
+                createOperator(version, type, inputs, outputs, attrs, attrBytes));
+        }
+        return graph;
+    }
+
+} // namespace infini
@@ -0,0 +1,11 @@
+#include "core/kernel.h"
+
+namespace infini
+{
+    void Kernel::launch(const LaunchRecord &record, void *, infinirtStream_t,
+                        const RuntimeObj *context) const
+    {
+        compute(record.op, context);
+    }
+
+} // namespace infini
@@ -0,0 +1,228 @@
+#include "core/memory_planner.h"
+#include <algorithm>
+
+namespace infini
+{
+    bool MemoryPlan::isPlanned(const Tensor &tensor) const
+    {
+        return offsets.count(tensor.get()) > 0;
+    }
+
+    size_t MemoryPlan::getOffset(const Tensor &tensor) const
+    {
+        auto it = offsets.find(tensor.get());
+        IT_ASSERT(it != offsets.end(), "Tensor is not planned in the arena");
+        return it->second;
+    }
+
+    string MemoryPlan::toString() const
+    {
+        std::ostringstream oss;
+        oss << "MemoryPlan(tensors=" << offsets.size()
+            << ", arena=" << arenaSize << "B"
+            << ", naive=" << naiveSize << "B"
+            << ", pinned=" << pinnedSize << "B"
+            << ", inplace=" << inplaceCount;
+        if (naiveSize > 0)
+            oss << ", saved=" << 100.0 * (naiveSize - arenaSize) / naiveSize << "%";
+        oss << ")";
+        return oss.str();
+    }
+
+    size_t MemoryPlanner::alignSize(size_t size)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    vector<MemoryPlanner::LiveRange>
+    MemoryPlanner::computeLiveRanges(const OpVec &ops, const TensorVec &tensors,
+                                     const TensorVec &outputs, MemoryPlan &plan)
+    {
+        std::unordered_map<OperatorObj *, size_t> opIndex;
+        for (size_t i = 0; i < ops.size(); ++i)
+            opIndex[ops[i].get()] = i;
+
+        vector<LiveRange> ranges;
+        for (auto &tensor : tensors)
+        {
+            // Tensors that already have storage (e.g. bound to caller-provided
+            // buffers or mapped weights) are not managed by the planner
+            if (tensor->getData())
+                continue;
+            auto source = tensor->getSource();
+            auto targets = tensor->getTargets();
+            // Weights, graph inputs and graph outputs stay pinned
+            if (!source || targets.empty() || !opIndex.count(source.get()) ||
+                std::find(outputs.begin(), outputs.end(), tensor) != outputs.end())
+            {
+                plan.pinnedSize += alignSize(tensor->getTotalBytes());
+                continue;
+            }
+            size_t begin = opIndex.at(source.get());
+            size_t end = begin;
+            vector<size_t> readers;
+            for (auto &target : targets)
+            {
+                IT_ASSERT(opIndex.count(target.get()),
+                          "Target op of tensor " + std::to_string(tensor->getFuid()) +
+                              " is not in graph");
+                readers.push_back(opIndex.at(target.get()));
+                end = std::max(end, readers.back());
+            }
+            ranges.push_back({{tensor}, alignSize(tensor->getTotalBytes()), begin, end,
+                              std::move(readers)});
+        }
+        return ranges;
+    }
+
+    void MemoryPlanner::mergeInplace(const OpVec &ops, const Reachability &reach,
+                                     vector<LiveRange> &ranges, MemoryPlan &plan)
+    {
+        // Readers on other streams may still run when `op` overwrites the input
+        auto othersBefore = [&](const LiveRange &range, size_t op)
+        {
+            return std::all_of(range.readers.begin(), range.readers.end(), [&](size_t r)
+                               { return r == op || ((reach[r][op / 64] >> (op % 64)) & 1); });
+        };
+        std::unordered_map<TensorObj *, size_t> rangeOf;
+        for (size_t i = 0; i < ranges.size(); ++i)
+            rangeOf[ranges[i].tensors.front().get()] = i;
+
+        vector<bool> merged(ranges.size(), false);
+        for (size_t opIdx = 0; opIdx < ops.size(); ++opIdx)
+        {
+            const auto &op = ops[opIdx];
+            for (auto [in, out] : op->getInplacePairs())
+            {
+                auto input = op->getInput(in), output = op->getOutput(out);
+                auto inIt = rangeOf.find(input.get());
+                auto outIt = rangeOf.find(output.get());
+                // Pinned tensors (graph inputs/outputs) are never aliased
+                if (inIt == rangeOf.end() || outIt == rangeOf.end())
+                    continue;
+                auto &dst = ranges[inIt->second];
+                auto &src = ranges[outIt->second];
+                // The input must die at this op, be read only once by it and
+                // be large enough to hold the output
+                const auto &inputs = op->getInputs();
+                if (dst.end != opIdx || merged[outIt->second] ||
+                    std::count(inputs.begin(), inputs.end(), input) != 1 ||
+                    src.size > dst.size || (!reach.empty() && !othersBefore(dst, opIdx)))
+                    continue;
+                dst.tensors.push_back(output);
+                dst.end = src.end;
+                dst.readers.insert(dst.readers.end(), src.readers.begin(),
+                                   src.readers.end());
+                merged[outIt->second] = true;
+                rangeOf[output.get()] = inIt->second;
+                ++plan.inplaceCount;
+            }
+        }
+
+        vector<LiveRange> result;
+        for (size_t i = 0; i < ranges.size(); ++i)
+        {
+            if (!merged[i])
+                result.push_back(std::move(ranges[i]));
+        }
+        ranges = std::move(result);
+    }
+
+    MemoryPlanner::Reachability
+    MemoryPlanner::computeReachability(const OpVec &ops, const vector<int> &streamOf)
+    {
+        std::unordered_map<OperatorObj *, size_t> opIndex;
+        for (size_t i = 0; i < ops.size(); ++i)
+            opIndex[ops[i].get()] = i;
+        size_t words = (ops.size() + 63) / 64;
+        Reachability reach(ops.size(), vector<uint64_t>(words, 0));
+        std::unordered_map<int, size_t> nextOnStream;
+        auto follow = [&](size_t i, size_t succ)
+        {
+            reach[i][succ / 64] |= uint64_t(1) << (succ % 64);
+            for (size_t w = 0; w < words; ++w)
+                reach[i][w] |= reach[succ][w];
+        };
+        for (size_t i = ops.size(); i-- > 0;)
+        {
+            for (auto &succ : ops[i]->getSuccessors())
+            {
+                auto it = opIndex.find(succ.get());
+                if (it != opIndex.end())
+                    follow(i, it->second);
+            }
+            // Ops without a stream are not ordered by one
+            if (streamOf[i] < 0)
+                continue;
+            auto it = nextOnStream.find(streamOf[i]);
+            if (it != nextOnStream.end())
+                follow(i, it->second);
+            nextOnStream[streamOf[i]] = i;
+        }
+        return reach;
+    }
+
+    MemoryPlan MemoryPlanner::plan(const OpVec &ops, const TensorVec &tensors,
+                                   const vector<int> &streamOf,
+                                   const TensorVec &outputs)
+    {
+        IT_ASSERT(streamOf.empty() || streamOf.size() == ops.size());
+        MemoryPlan plan;
+        auto ranges = computeLiveRanges(ops, tensors, outputs, plan);
+        for (auto &range : ranges)
+            plan.naiveSize += range.size;
+        Reachability reach;
+        if (!streamOf.empty())
+            reach = computeReachability(ops, streamOf);
+        mergeInplace(ops, reach, ranges, plan);
+        // Whether `a` and `b` may be alive at the same time
+        auto conflict = [&](const LiveRange &a, const LiveRange &b)
+        {
+            if (reach.empty())
+                return a.begin <= b.end && b.begin <= a.end;
+            auto allBefore = [&](const vector<size_t> &readers, size_t op)
+            {
+                return std::all_of(readers.begin(), readers.end(), [&](size_t r)
+                                   { return (reach[r][op / 64] >> (op % 64)) & 1; });
+            };
+            return !allBefore(a.readers, b.begin) && !allBefore(b.readers, a.begin);
+        };
+
+        // Greedy by size: place large tensors first, each at the lowest offset
+        // that does not collide with an already placed tensor alive at the
+        // same time.
+        std::stable_sort(ranges.begin(), ranges.end(),
+                         [](const LiveRange &a, const LiveRange &b)
+                         {
+                             if (a.size != b.size)
+                                 return a.size > b.size;
+                             return a.begin < b.begin;
+                         });
+
+        vector<pair<const LiveRange *, size_t>> placed;
+        for (auto &range : ranges)
+        {
+            vector<pair<size_t, size_t>> busy; // [offset, offset + size)
+            for (auto &[other, offset] : placed)
+            {
+                if (conflict(*other, range))
+                    busy.emplace_back(offset, offset + other->size);
+            }
+            std::sort(busy.begin(), busy.end());
+
+            size_t offset = 0;
+            for (auto &[lo, hi] : busy)
+            {
+                if (lo >= offset + range.size)
+                    break;
+                offset = std::max(offset, hi);
+            }
+            placed.emplace_back(&range, offset);
+            for (auto &tensor : range.tensors)
+                plan.offsets[tensor.get()] = offset;
+            plan.arenaSize = std::max(plan.arenaSize, offset + range.size);
+        }
+        return plan;
+    }
+
+} // namespace infini
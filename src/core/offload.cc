@@ -0,0 +1,202 @@
+#include "core/offload.h"
+#include "core/runtime.h"
+#include <algorithm>
+
+namespace infini
+{
+    string OffloadManager::Stats::toString() const
+    {
+        std::ostringstream oss;
+        oss << "Offload(h2d=" << h2dBytes << "B, d2h=" << d2hBytes
+            << "B, prefetches=" << prefetches << ", evictions=" << evictions
+            << ", peak=" << peakDeviceBytes << "B)";
+        return oss.str();
+    }
+
+    OffloadManager::OffloadManager(Runtime runtime_, size_t budget, size_t fixedBytes,
+                                   const OpVec &ops, const TensorVec &managed)
+        : runtime(std::move(runtime_)), budget(budget), fixedBytes(fixedBytes),
+          opEntries(ops.size() + 1)
+    {
+        IT_ASSERT(fixedBytes <= budget, "Memory budget of " + std::to_string(budget) +
+                                            "B is smaller than the activation arena");
+        CHECK_INFINI_ERROR(infinirtStreamCreate(&copyStream));
+
+        std::unordered_map<OperatorObj *, size_t> opIndex;
+        for (size_t i = 0; i < ops.size(); ++i)
+            opIndex[ops[i].get()] = i;
+        for (auto &tensor : managed)
+        {
+            IT_ASSERT(tensor->getData() == nullptr);
+            size_t bytes = tensor->getTotalBytes();
+            auto rt = runtime;
+            Ref<void> hostMemory(runtime->allocHost(bytes),
+                                 [rt](void *ptr)
+                                 { rt->deallocHost(ptr); });
+            auto host = make_ref<BlobObj>(hostMemory.get(), hostMemory,
+                                          MemoryLocation::Host);
+            tensor->attachBlob(host);
+
+            Entry entry{tensor, bytes, host};
+            if (auto source = tensor->getSource())
+                entry.uses.push_back(opIndex.at(source.get()));
+            for (auto &target : tensor->getTargets())
+                entry.uses.push_back(opIndex.at(target.get()));
+            std::sort(entry.uses.begin(), entry.uses.end());
+            entry.uses.erase(std::unique(entry.uses.begin(), entry.uses.end()),
+                             entry.uses.end());
+            for (auto use : entry.uses)
+                opEntries[use].push_back(entries.size());
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    OffloadManager::~OffloadManager()
+    {
+        for (auto &entry : entries)
+        {
+            if (entry.ready)
+                infinirtEventDestroy(entry.ready);
+        }
+        if (copyStream)
+        {
+            infinirtStreamSynchronize(copyStream);
+            // Device blobs are released on the copy stream, drop them first
+            for (auto &entry : entries)
+                entry.device.reset();
+            infinirtStreamDestroy(copyStream);
+        }
+    }
+
+    bool OffloadManager::isResident(const Entry &entry) const
+    {
+        return entry.device != nullptr;
+    }
+
+    size_t OffloadManager::nextUse(const Entry &entry, size_t idx) const
+    {
+        auto it = std::lower_bound(entry.uses.begin(), entry.uses.end(), idx);
+        // Not used again in this run: needed first by the next one
+        return it == entry.uses.end() ? SIZE_MAX : *it;
+    }
+
+    void OffloadManager::beginRun()
+    {
+        stats = Stats();
+        stats.peakDeviceBytes = fixedBytes + residentBytes;
+    }
+
+    void OffloadManager::evict(Entry &entry, infinirtStream_t stream)
+    {
+        // The copy stream must not touch the buffer before queued kernels
+        infinirtEvent_t event = nullptr;
+        CHECK_INFINI_ERROR(infinirtEventCreate(&event));
+        CHECK_INFINI_ERROR(infinirtEventRecord(event, stream));
+        CHECK_INFINI_ERROR(infinirtStreamWaitEvent(copyStream, event));
+        CHECK_INFINI_ERROR(infinirtEventDestroy(event));
+        // A weight written while resident has no valid host copy any more
+        if (!entry.tensor->isWeight() ||
+            entry.tensor->getHostWrites() != entry.hostWrites)
+        {
+            runtime->memcpyAsync(entry.host->getPtr<void *>(),
+                                 entry.device->getPtr<void *>(), entry.bytes,
+                                 INFINIRT_MEMCPY_D2H, copyStream);
+            stats.d2hBytes += entry.bytes;
+            entry.hostWrites = entry.tensor->getHostWrites();
+        }
+        if (entry.ready)
+        {
+            CHECK_INFINI_ERROR(infinirtEventDestroy(entry.ready));
+            entry.ready = nullptr;
+        }
+        entry.tensor->attachBlob(entry.host);
+        // Freed on the copy stream, behind the copy above
+        entry.device = nullptr;
+        residentBytes -= entry.bytes;
+        ++stats.evictions;
+    }
+
+    bool OffloadManager::makeRoom(size_t bytes, size_t idx, infinirtStream_t stream)
+    {
+        while (fixedBytes + residentBytes + bytes > budget)
+        {
+            // Belady: evict the tensor needed again farthest in the future,
+            // never one used by the current or the next op
+            Entry *victim = nullptr;
+            size_t victimUse = 0;
+            for (auto &entry : entries)
+            {
+                if (!isResident(entry))
+                    continue;
+                size_t use = nextUse(entry, idx);
+                if (use <= idx + 1)
+                    continue;
+                if (!victim || use > victimUse)
+                {
+                    victim = &entry;
+                    victimUse = use;
+                }
+            }
+            if (!victim)
+                return false;
+            evict(*victim, stream);
+        }
+        return true;
+    }
+
+    bool OffloadManager::upload(size_t entryIdx, size_t idx, infinirtStream_t stream)
+    {
+        auto &entry = entries[entryIdx];
+        if (isResident(entry))
+            return true;
+        if (!makeRoom(entry.bytes, idx, stream))
+            return false;
+        void *ptr = runtime->mallocAsync(entry.bytes, copyStream);
+        entry.device = make_ref<BlobObj>(runtime, ptr, copyStream);
+        // Outputs are fully written by their producer, no upload needed
+        bool produced = entry.tensor->getSource() &&
+                        nextUse(entry, idx) == entry.uses.front();
+        if (!produced)
+        {
+            runtime->memcpyAsync(ptr, entry.host->getPtr<void *>(), entry.bytes,
+                                 INFINIRT_MEMCPY_H2D, copyStream);
+            stats.h2dBytes += entry.bytes;
+        }
+        CHECK_INFINI_ERROR(infinirtEventCreate(&entry.ready));
+        CHECK_INFINI_ERROR(infinirtEventRecord(entry.ready, copyStream));
+        entry.hostWrites = entry.tensor->getHostWrites();
+        entry.tensor->attachBlob(entry.device);
+        residentBytes += entry.bytes;
+        stats.peakDeviceBytes = std::max(stats.peakDeviceBytes, fixedBytes + residentBytes);
+        return true;
+    }
+
+    void OffloadManager::beforeOp(size_t idx, infinirtStream_t stream)
+    {
+        for (auto entryIdx : opEntries[idx])
+        {
+            IT_ASSERT(upload(entryIdx, idx, stream),
+                      "Memory budget of " + std::to_string(budget) +
+                          "B cannot hold the tensors of op " + std::to_string(idx));
+        }
+        for (auto entryIdx : opEntries[idx])
+        {
+            auto &entry = entries[entryIdx];
+            if (entry.ready)
+            {
+                CHECK_INFINI_ERROR(infinirtStreamWaitEvent(stream, entry.ready));
+                CHECK_INFINI_ERROR(infinirtEventDestroy(entry.ready));
+                entry.ready = nullptr;
+            }
+        }
+        // Prefetch for the next op while this one computes
+        for (auto entryIdx : opEntries[idx + 1])
+        {
+            if (!isResident(entries[entryIdx]) && upload(entryIdx, idx, stream))
+                ++stats.prefetches;
+        }
+    }
+
+    const OffloadManager::Stats &OffloadManager::getStats() const { return stats; }
+
+} // namespace infini
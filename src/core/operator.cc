@@ -1,5 +1,6 @@
 #include "core/operator.h"
 #include "core/graph.h"
+#include "core/runtime.h"
 
 namespace infini
 {
@@ -56,6 +57,56 @@ namespace infini
         return infiniOpDesc;
     };
 
+    void *OperatorObj::getInfiniOpDesc(const RuntimeObj *runtime)
+    {
+        auto handle = runtime->getHandle();
+        if (!opDesc || descHandle != handle)
+        {
+            auto key = getDescKey();
+            opDesc = runtime->getDescriptorCache().getOrCreate(
+                key, [&]
+                { return createOpDesc(handle); });
+            infiniOpDesc = opDesc.get();
+            descKey = key.str();
+            descHandle = handle;
+        }
+        return infiniOpDesc;
+    }
+
+    void OperatorObj::resetOpDesc()
+    {
+        opDesc = nullptr;
+        infiniOpDesc = nullptr;
+        descKey.clear();
+        kernel = nullptr;
+        descHandle = nullptr;
+    }
+
+    DescriptorKey OperatorObj::getDescKey() const
+    {
+        DescriptorKey key(type);
+        for (auto &input : inputs)
+            key.add(input);
+        for (auto &output : outputs)
+            key.add(output);
+        addDescAttrs(key);
+        return key;
+    }
+
+    void OperatorObj::addDescAttrs(DescriptorKey &) const {}
+
+    Operator OperatorObj::clone(const TensorVec &, const TensorVec &) const
+    {
+        IT_TODO_HALT_MSG(string("Clone of ") + type.toString());
+        return nullptr;
+    }
+
+    bool OperatorObj::addAttrs(DescriptorKey &) const { return false; }
+
+    size_t OperatorObj::getWorkspaceSize(const RuntimeObj *) { return 0; }
+
+    vector<pair<int, int>> OperatorObj::getInplacePairs() const { return {}; }
+
     void OperatorObj::removePredecessors(const Operator &op)
     {
         for (auto it = predecessors.begin(); it != predecessors.end();)
@@ -0,0 +1,121 @@
+#include "core/pass_manager.h"
+#include "core/graph.h"
+#include "core/graph_passes.h"
+#include <chrono>
+
+namespace infini
+{
+    bool PassReport::changed() const
+    {
+        return std::any_of(passes.begin(), passes.end(),
+                           [](const PassStats &pass)
+                           { return pass.changed; });
+    }
+
+    string PassReport::toString() const
+    {
+        std::ostringstream oss;
+        oss << "PassReport(total=" << totalMs << "ms)";
+        for (auto &pass : passes)
+        {
+            oss << "\n  " << pass.name << ": " << pass.ms << "ms, ops "
+                << pass.opsBefore << " -> " << pass.opsAfter << ", tensors "
+                << pass.tensorsBefore << " -> " << pass.tensorsAfter
+                << (pass.changed ? "" : " (unchanged)");
+        }
+        return oss.str();
+    }
+
+    PassManager PassManager::create(OptLevel level)
+    {
+        PassManager manager;
+        if (level >= OptLevel::O1)
+        {
+            manager.addPass(make_ref<PruneDanglingTensorsPass>());
+            manager.addPass(make_ref<EliminateDeadCodePass>());
+            manager.addPass(make_ref<EliminateCommonSubexpressionsPass>());
+            manager.addPass(make_ref<AbsorbTransposePass>());
+            manager.addPass(make_ref<FoldConstantsPass>());
+            manager.addPass(make_ref<FuseGemmActivationPass>());
+        }
+        return manager;
+    }
+
+    void PassManager::addPass(Ref<GraphPass> pass)
+    {
+        IT_ASSERT(pass != nullptr);
+        passes.push_back(std::move(pass));
+    }
+
+    void PassManager::insertPass(const string &before, Ref<GraphPass> pass)
+    {
+        IT_ASSERT(pass != nullptr);
+        auto it = std::find_if(passes.begin(), passes.end(),
+                               [&](const Ref<GraphPass> &p)
+                               { return p->getName() == before; });
+        passes.insert(it, std::move(pass));
+    }
+
+    bool PassManager::removePass(const string &name)
+    {
+        auto it = std::find_if(passes.begin(), passes.end(),
+                               [&](const Ref<GraphPass> &p)
+                               { return p->getName() == name; });
+        if (it == passes.end())
+            return false;
+        passes.erase(it);
+        return true;
+    }
+
+    vector<string> PassManager::getPassNames() const
+    {
+        vector<string> names;
+        for (auto &pass : passes)
+            names.push_back(pass->getName());
+        return names;
+    }
+
+    void PassManager::setValidate(bool validate_) { validate = validate_; }
+
+    bool PassManager::getValidate() const { return validate; }
+
+    PassReport PassManager::run(GraphObj &graph) const
+    {
+        using Clock = std::chrono::steady_clock;
+        auto elapsedMs = [](Clock::time_point begin)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        };
+        PassReport report;
+        auto runBegin = Clock::now();
+        for (auto &pass : passes)
+        {
+            PassStats stats;
+            stats.name = pass->getName();
+            stats.opsBefore = graph.getOperators().size();
+            stats.tensorsBefore = graph.getTensors().size();
+            auto begin = Clock::now();
+            stats.changed = pass->run(graph);
+            stats.ms = elapsedMs(begin);
+            stats.opsAfter = graph.getOperators().size();
+            stats.tensorsAfter = graph.getTensors().size();
+            if (validate)
+            {
+                try
+                {
+                    IT_ASSERT(graph.topo_sort(), "Graph has a cycle");
+                    graph.checkValid();
+                }
+                catch (const std::exception &e)
+                {
+                    IT_ASSERT(false, "Graph is invalid after pass " + stats.name +
+                                         ": " + e.what());
+                }
+            }
+            report.passes.push_back(std::move(stats));
+        }
+        report.totalMs = elapsedMs(runBegin);
+        return report;
+    }
+
+} // namespace infini
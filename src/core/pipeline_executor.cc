@@ -0,0 +1,360 @@
+#include "core/pipeline_executor.h"
+#include "operators/Gemm.h"
+#include <chrono>
+#include <limits>
+
+namespace infini
+{
+    string PipelineExecutor::RunStats::toString() const
+    {
+        std::ostringstream oss;
+        oss << "Pipeline(wall=" << wallMs << "ms)";
+        for (size_t s = 0; s < stages.size(); ++s)
+        {
+            auto &stage = stages[s];
+            oss << "\n  stage " << s << ": ops [" << stage.firstOp << ", "
+                << stage.firstOp + stage.numOps << "), cost=" << stage.estimatedCost
+                << ", busy=" << stage.busyMs << "ms, bubble=" << stage.bubbleMs
+                << "ms, utilization=" << 100 * stage.utilization << "%";
+        }
+        return oss.str();
+    }
+
+    double PipelineExecutor::estimateCost(const Operator &op)
+    {
+        double cost = op->getOutput(0)->getElement();
+        if (op->getOpType() == OpType::Gemm)
+        {
+            auto shape = op->getInput(0)->getShape();
+            cost *= as<GemmObj>(op)->getTransA() ? shape[shape.size() - 2] : shape.back();
+        }
+        return cost;
+    }
+
+    vector<size_t> PipelineExecutor::partition(const vector<double> &costs, size_t numStages)
+    {
+        size_t n = costs.size();
+        IT_ASSERT(numStages > 0 && n >= numStages, "Fewer ops than pipeline stages");
+        vector<double> prefix(n + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+            prefix[i + 1] = prefix[i] + costs[i];
+        // best[s][i]: smallest max stage cost of the first i ops in s stages
+        const double inf = std::numeric_limits<double>::infinity();
+        vector<vector<double>> best(numStages + 1, vector<double>(n + 1, inf));
+        vector<vector<size_t>> cut(numStages + 1, vector<size_t>(n + 1, 0));
+        best[0][0] = 0;
+        for (size_t s = 1; s <= numStages; ++s)
+        {
+            for (size_t i = s; i <= n; ++i)
+            {
+                for (size_t j = s - 1; j < i; ++j)
+                {
+                    double cost = std::max(best[s - 1][j], prefix[i] - prefix[j]);
+                    if (cost < best[s][i])
+                    {
+                        best[s][i] = cost;
+                        cut[s][i] = j;
+                    }
+                }
+            }
+        }
+        vector<size_t> firstOps(numStages);
+        for (size_t s = numStages, i = n; s > 0; --s)
+        {
+            i = cut[s][i];
+            firstOps[s - 1] = i;
+        }
+        return firstOps;
+    }
+
+    PipelineExecutor::PipelineExecutor(Runtime runtime_, const Graph &graph,
+                                       TensorVec inputs, Config config_)
+        : runtime(std::move(runtime_)), config(std::move(config_)),
+          graphInputs(std::move(inputs))
+    {
+        IT_ASSERT(config.numMicroBatches > 0 && config.queueDepth > 0);
+        IT_ASSERT(graph->topo_sort(), "Graph has a cycle");
+        const auto &ops = graph->getOperators();
+        vector<double> costs;
+        for (auto &op : ops)
+            costs.push_back(config.cost ? config.cost(op) : estimateCost(op));
+        auto firstOps = partition(costs, config.numStages);
+
+        for (auto &tensor : graph->getTensors())
+        {
+            IT_ASSERT(!tensor->getSource() ||
+                          std::find(graphInputs.begin(), graphInputs.end(), tensor) ==
+                              graphInputs.end(),
+                      "Graph inputs must not be produced by an op");
+            if (tensor->getSource() && tensor->getTargets().empty())
+                graphOutputs.push_back(tensor);
+        }
+        buildStages(graph, firstOps);
+
+        stats.stages.resize(config.numStages);
+        for (size_t s = 0; s < config.numStages; ++s)
+        {
+            auto &stage = stats.stages[s];
+            stage.firstOp = firstOps[s];
+            stage.numOps = (s + 1 < firstOps.size() ? firstOps[s + 1] : ops.size()) -
+                           firstOps[s];
+            for (size_t i = 0; i < stage.numOps; ++i)
+                stage.estimatedCost += costs[stage.firstOp + i];
+        }
+
+        for (size_t s = 0; s < config.numStages; ++s)
+            queues.push_back(std::make_unique<BoundedQueue<MicroBatch>>(config.queueDepth));
+        // Room for a whole run, so the last stage never waits for the caller
+        queues.push_back(std::make_unique<BoundedQueue<MicroBatch>>(config.numMicroBatches));
+        auto device = runtime->getCurrentThreadContext()->device;
+        for (size_t s = 0; s < config.numStages; ++s)
+            stages[s]->thread = std::thread([this, s, device]
+                                            {
+                                                stageLoop(s, device);
+                                                runtime->releaseThreadContext();
+                                            });
+    }
+
+    PipelineExecutor::~PipelineExecutor()
+    {
+        for (auto &queue : queues)
+            queue->close();
+        for (auto &stage : stages)
+            stage->thread.join();
+    }
+
+    void PipelineExecutor::buildStages(const Graph &graph, const vector<size_t> &firstOps)
+    {
+        const auto &ops = graph->getOperators();
+        size_t numStages = firstOps.size();
+        std::unordered_map<OperatorObj *, size_t> stageOf;
+        for (size_t s = 0; s < numStages; ++s)
+        {
+            size_t end = s + 1 < numStages ? firstOps[s + 1] : ops.size();
+            for (size_t i = firstOps[s]; i < end; ++i)
+                stageOf[ops[i].get()] = s;
+        }
+        // Last stage reading each activation; graph outputs live to the end
+        std::unordered_map<TensorObj *, size_t> lastUse;
+        for (auto &op : ops)
+        {
+            for (auto &input : op->getInputs())
+                lastUse[input.get()] = std::max(lastUse[input.get()], stageOf[op.get()]);
+        }
+        for (auto &output : graphOutputs)
+            lastUse[output.get()] = numStages;
+
+        std::unordered_set<TensorObj *> isInput;
+        for (auto &input : graphInputs)
+            isInput.insert(input.get());
+        auto isWeight = [&](TensorObj *tensor)
+        {
+            return !tensor->getSource() && !isInput.count(tensor);
+        };
+        auto context = runtime->getCurrentThreadContext();
+        size_t numMicro = config.numMicroBatches;
+        for (size_t s = 0; s < numStages; ++s)
+        {
+            auto stage = std::make_unique<Stage>();
+            stage->deviceId = config.devices.empty()
+                                  ? context->deviceId
+                                  : config.devices[s % config.devices.size()];
+            size_t end = s + 1 < numStages ? firstOps[s + 1] : ops.size();
+            OpVec subOps(ops.begin() + firstOps[s], ops.begin() + end);
+            stage->graph = graph->extractSubgraph(subOps, stage->tensors);
+
+            TensorVec resized;
+            for (auto &[original, local] : stage->tensors)
+            {
+                if (isWeight(original) && stage->deviceId != context->deviceId)
+                {
+                    vector<uint8_t> host(original->getTotalBytes());
+                    original->copyToHost(runtime, host.data());
+                    stage->weights.emplace_back(local, std::move(host));
+                }
+            }
+            // Deterministic order of the tensors exchanged with other stages
+            for (auto &tensor : graph->getTensors())
+            {
+                auto it = stage->tensors.find(tensor.get());
+                if (it == stage->tensors.end() || isWeight(tensor.get()))
+                    continue;
+                auto source = tensor->getSource();
+                bool produced = source && stageOf.at(source.get()) == s;
+                if (!produced)
+                {
+                    Shape shape = tensor->getShape();
+                    IT_ASSERT(!shape.empty() && shape[0] % numMicro == 0,
+                              "Batch dimension must be divisible by the number of micro-batches");
+                    shape[0] /= numMicro;
+                    it->second->setShape(shape);
+                    resized.push_back(it->second);
+                    stage->inputs.push_back(tensor);
+                    if (lastUse.at(tensor.get()) == s)
+                        stage->expired.push_back(tensor.get());
+                }
+                else if (lastUse.count(tensor.get()) && lastUse.at(tensor.get()) > s)
+                {
+                    stage->outputs.push_back(tensor);
+                }
+            }
+            // Storage is allocated later by the stage's own thread
+            stage->graph->shape_infer(resized);
+            for (auto &output : stage->outputs)
+            {
+                IT_ASSERT(stage->tensors.at(output.get())->getShape()[0] * numMicro ==
+                              output->getShape()[0],
+                          "Activations must keep the batch dimension first");
+            }
+            stages.push_back(std::move(stage));
+        }
+    }
+
+    void PipelineExecutor::stageLoop(size_t idx, infiniDevice_t device)
+    {
+        auto &stage = *stages[idx];
+        std::exception_ptr setupError;
+        try
+        {
+            runtime->initThreadContext(device, stage.deviceId);
+            for (auto &[tensor, host] : stage.weights)
+            {
+                tensor->attachBlob(make_ref<BlobObj>(
+                    runtime, runtime->allocDevice(tensor->getTotalBytes()),
+                    runtime->getCurrentStream()));
+                tensor->copyFromHost(runtime, host.data());
+            }
+            stage.weights.clear();
+            // Inputs of an allocated graph came with the original's storage
+            for (auto &input : stage.inputs)
+            {
+                auto local = stage.tensors.at(input.get());
+                if (local->getData())
+                    local->attachBlob(make_ref<BlobObj>(
+                        runtime, runtime->allocDevice(local->getTotalBytes()),
+                        runtime->getCurrentStream()));
+            }
+            stage.graph->dataMalloc();
+            runtime->prepare(stage.graph);
+        }
+        catch (...)
+        {
+            setupError = std::current_exception();
+        }
+
+        MicroBatch batch;
+        while (queues[idx]->pop(batch))
+        {
+            // A failed micro-batch is passed on untouched to reach the caller
+            if (!batch.error && setupError)
+                batch.error = setupError;
+            if (!batch.error)
+            {
+                auto begin = std::chrono::steady_clock::now();
+                try
+                {
+                    process(stage, batch);
+                }
+                catch (...)
+                {
+                    batch.error = std::current_exception();
+                }
+                stage.busyMs += std::chrono::duration<double, std::milli>(
+                                    std::chrono::steady_clock::now() - begin)
+                                    .count();
+            }
+            if (!queues[idx + 1]->push(std::move(batch)))
+                return;
+        }
+    }
+
+    void PipelineExecutor::process(Stage &stage, MicroBatch &batch)
+    {
+        for (auto &input : stage.inputs)
+            stage.tensors.at(input.get())->copyFromHost(runtime,
+                                                        batch.tensors.at(input.get()).data());
+        runtime->run(stage.graph);
+        for (auto &output : stage.outputs)
+        {
+            auto local = stage.tensors.at(output.get());
+            vector<uint8_t> host(local->getTotalBytes());
+            local->copyToHost(runtime, host.data());
+            batch.tensors[output.get()] = std::move(host);
+        }
+        for (auto tensor : stage.expired)
+            batch.tensors.erase(tensor);
+    }
+
+    void PipelineExecutor::run(const std::map<Tensor, const void *> &inputs)
+    {
+        for (auto &input : graphInputs)
+            IT_ASSERT(inputs.count(input), "Missing data of a graph input");
+        for (auto &stage : stages)
+            stage->busyMs = 0;
+        size_t numMicro = config.numMicroBatches;
+        auto begin = std::chrono::steady_clock::now();
+
+        for (size_t m = 0; m < numMicro; ++m)
+        {
+            MicroBatch batch;
+            batch.index = m;
+            for (auto &[tensor, data] : inputs)
+            {
+                size_t bytes = tensor->getTotalBytes() / numMicro;
+                auto src = static_cast<const uint8_t *>(data) + m * bytes;
+                batch.tensors[tensor.get()] = vector<uint8_t>(src, src + bytes);
+            }
+            IT_ASSERT(queues.front()->push(std::move(batch)));
+        }
+
+        std::exception_ptr error;
+        for (auto &output : graphOutputs)
+            results[output.get()].resize(output->getTotalBytes());
+        for (size_t m = 0; m < numMicro; ++m)
+        {
+            MicroBatch batch;
+            IT_ASSERT(queues.back()->pop(batch));
+            if (batch.error)
+            {
+                if (!error)
+                    error = batch.error;
+                continue;
+            }
+            for (auto &output : graphOutputs)
+            {
+                auto &rows = batch.tensors.at(output.get());
+                std::memcpy(results[output.get()].data() + batch.index * rows.size(),
+                            rows.data(), rows.size());
+            }
+        }
+
+        stats.wallMs = std::chrono::duration<double, std::milli>(
+                           std::chrono::steady_clock::now() - begin)
+                           .count();
+        for (size_t s = 0; s < stages.size(); ++s)
+        {
+            auto &stage = stats.stages[s];
+            stage.busyMs = stages[s]->busyMs;
+            stage.bubbleMs = std::max(0.0, stats.wallMs - stage.busyMs);
+            stage.utilization = stats.wallMs > 0 ? stage.busyMs / stats.wallMs : 0;
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void PipelineExecutor::getOutput(const Tensor &tensor, void *dst) const
+    {
+        auto it = results.find(tensor.get());
+        IT_ASSERT(it != results.end(), "Tensor is not a graph output");
+        std::memcpy(dst, it->second.data(), it->second.size());
+    }
+
+    const PipelineExecutor::RunStats &PipelineExecutor::getStats() const { return stats; }
+
+    const Graph &PipelineExecutor::getStageGraph(size_t stage) const
+    {
+        IT_ASSERT(stage < stages.size());
+        return stages[stage]->graph;
+    }
+
+} // namespace infini
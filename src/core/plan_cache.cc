@@ -0,0 +1,58 @@
+#include "core/plan_cache.h"
+
+namespace infini
+{
+    string PlanCache::key(const TensorVec &inputs)
+    {
+        std::ostringstream oss;
+        for (auto &tensor : inputs)
+        {
+            oss << tensor->getFuid() << ":";
+            for (auto dim : tensor->getShape())
+                oss << dim << ",";
+            oss << ";";
+        }
+        return oss.str();
+    }
+
+    const PreparedShape *PlanCache::find(const string &key)
+    {
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [&](const auto &entry)
+                               { return entry.first == key; });
+        if (it == entries.end())
+        {
+            ++misses;
+            return nullptr;
+        }
+        ++hits;
+        entries.splice(entries.begin(), entries, it);
+        return &entries.front().second;
+    }
+
+    void PlanCache::insert(const string &key, PreparedShape entry)
+    {
+        entries.remove_if([&](const auto &e)
+                          { return e.first == key; });
+        entries.emplace_front(key, std::move(entry));
+        while (entries.size() > capacity)
+            entries.pop_back();
+    }
+
+    void PlanCache::clear() { entries.clear(); }
+
+    void PlanCache::setCapacity(size_t capacity_)
+    {
+        IT_ASSERT(capacity_ > 0);
+        capacity = capacity_;
+        while (entries.size() > capacity)
+            entries.pop_back();
+    }
+
+    size_t PlanCache::size() const { return entries.size(); }
+
+    size_t PlanCache::getHits() const { return hits; }
+
+    size_t PlanCache::getMisses() const { return misses; }
+
+} // namespace infini
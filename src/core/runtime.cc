@@ -4,6 +4,14 @@ namespace infini
 {
     thread_local Context g_currentCtx = nullptr;
 
+    ContextObj::~ContextObj()
+    {
+        // Contexts live as long as the runtime, past the graphs using them
+        descriptors.clear();
+        if (handle)
+            infiniopDestroyHandle(handle);
+    }
+
     Runtime &RuntimeObj::getInstance()
     {
         static Runtime instance = make_ref<RuntimeObj>();
@@ -24,12 +32,34 @@ namespace infini
             g_currentCtx->device = device;
             g_currentCtx->deviceId = deviceId;
             g_currentCtx->stream = stream;
+            CHECK_INFINI_ERROR(infiniopCreateHandle(&g_currentCtx->handle));
 
             std::lock_guard<std::mutex> lock(mtx);
             threadContexts[std::this_thread::get_id()] = g_currentCtx;
         }
     }
 
+    void RuntimeObj::releaseThreadContext()
+    {
+        if (!g_currentCtx)
+            return;
+        // Kernels still reading the workspace are queued on this stream
+        streamSynchronize(g_currentCtx->stream);
+        allocator.free(g_currentCtx->workspace);
+        g_currentCtx->workspace = nullptr;
+        g_currentCtx->workspaceSize = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            threadContexts.erase(std::this_thread::get_id());
+        }
+        g_currentCtx = nullptr;
+    }
+
+    infinirtStream_t RuntimeObj::getCurrentStream() const
+    {
+        return g_currentCtx ? g_currentCtx->stream : nullptr;
+    }
+
     Context RuntimeObj::getCurrentThreadContext() const
     {
         // thread_local Context currentCtx;
@@ -40,6 +70,16 @@ namespace infini
         return g_currentCtx;
     }
 
+    infiniopHandle_t RuntimeObj::getHandle() const
+    {
+        return getCurrentThreadContext()->handle;
+    }
+
+    DescriptorCache &RuntimeObj::getDescriptorCache() const
+    {
+        return getCurrentThreadContext()->descriptors;
+    }
+
     void RuntimeObj::setCurrentDevice(infiniDevice_t device, int deviceId)
     {
         CHECK_INFINI_ERROR(infinirtSetDevice(device, deviceId));
@@ -55,21 +95,113 @@ namespace infini
         CHECK_INFINI_ERROR(infinirtGetAllDeviceCount(count_array));
     }
 
-    void RuntimeObj::run(const Graph &graph) const
+    void RuntimeObj::prepare(const Graph &graph, OptLevel level) const
     {
-        // TODO: 目前仅支持单卡，后续支持多卡
-
-        const auto &kernelRegistry = KernelRegistry::getInstance();
+        graph->optimize(level);
+        auto context = getCurrentThreadContext();
+        auto plan = make_ref<ExecutionPlan>();
+        plan->handle = context->handle;
+        plan->refreshData = graph->getOffloader() != nullptr;
+        plan->workspaceSize = graph->getWorkspaceSize();
+        plan->records.reserve(graph->getOperators().size());
         for (auto &op : graph->getOperators())
         {
+            LaunchRecord record;
+            record.kernel = autotuner.select(op, this);
+            record.op = op;
+            record.desc = op->getInfiniOpDesc(this);
+            record.workspaceSize = op->getWorkspaceSize(this);
+            ExecutionPlan::fillData(record);
+            plan->records.push_back(std::move(record));
+        }
+        reserveWorkspace(plan->workspaceSize);
+        graph->setPlan(plan);
+    }
+
+    void RuntimeObj::run(const Graph &graph) const
+    {
+        // 只在当前线程的设备上执行；多卡由 TensorParallelExecutor 为每个 rank 起一个线程调用 run
+        auto plan = graph->getPlan();
+        if (plan && plan->handle == getHandle())
+        {
+            runPlan(graph, *plan);
+            return;
+        }
+        reserveWorkspace(graph->getWorkspaceSize());
+        auto offloader = graph->getOffloader();
+        if (offloader)
+            offloader->beginRun();
+        const auto &ops = graph->getOperators();
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            const auto &op = ops[i];
             auto context = getCurrentThreadContext();
-            auto device = context->device;
-            auto kernelAttrs = KernelAttrs{device, op->getOpType().underlying()};
-            Kernel *kernel = kernelRegistry.getKernel(kernelAttrs);
+            if (offloader)
+                offloader->beforeOp(i, context->stream);
+            auto kernel = autotuner.select(op, this);
             kernel->compute(op, this);
         }
     }
 
+    RunFuture RuntimeObj::runAsync(const Graph &graph,
+                                   const std::map<Tensor, const void *> &inputs) const
+    {
+        IT_ASSERT(graph->getOffloader() == nullptr,
+                  "Asynchronous runs do not support host offloading");
+        auto plan = graph->getPlan();
+        if (!plan || plan->handle != getHandle())
+        {
+            prepare(graph);
+            plan = graph->getPlan();
+        }
+        // Slots copied the records; rebound storage needs new ones
+        bool rebound = plan->refreshStaleData();
+        auto pool = graph->getAsyncPool();
+        if (!pool || rebound || !pool->matches(plan, inputs, maxInFlightRuns))
+        {
+            std::set<TensorObj *> inputSet;
+            for (auto &[tensor, data] : inputs)
+                inputSet.insert(tensor.get());
+            // Runs still using the old buffers finish first
+            graph->setAsyncPool(nullptr);
+            pool = make_ref<AsyncRunPool>(graph, plan, inputSet, maxInFlightRuns);
+            graph->setAsyncPool(pool);
+        }
+        return pool->run(inputs);
+    }
+
+    void RuntimeObj::setMaxInFlightRuns(size_t n)
+    {
+        IT_ASSERT(n > 0);
+        maxInFlightRuns = n;
+    }
+
+    size_t RuntimeObj::getMaxInFlightRuns() const { return maxInFlightRuns; }
+
+    void RuntimeObj::runPlan(const Graph &graph, ExecutionPlan &plan) const
+    {
+        auto context = getCurrentThreadContext();
+        reserveWorkspace(plan.workspaceSize);
+        void *workspace = context->workspace;
+        infinirtStream_t stream = context->stream;
+        if (!plan.refreshData)
+        {
+            plan.refreshStaleData();
+            for (const auto &record : plan.records)
+                record.kernel->launch(record, workspace, stream, this);
+            return;
+        }
+        auto offloader = graph->getOffloader();
+        offloader->beginRun();
+        for (size_t i = 0; i < plan.records.size(); ++i)
+        {
+            auto &record = plan.records[i];
+            offloader->beforeOp(i, stream);
+            ExecutionPlan::fillData(record);
+            record.kernel->launch(record, workspace, stream, this);
+        }
+    }
+
     void *RuntimeObj::allocHost(size_t size)
     {
         void *ptr;
@@ -77,11 +209,9 @@ namespace infini
         return ptr;
     }
 
-    void *RuntimeObj::allocDevice(size_t size)
+    void *RuntimeObj::allocDevice(size_t size) const
     {
-        void *ptr;
-        CHECK_INFINI_ERROR(infinirtMalloc(&ptr, size));
-        return ptr;
+        return allocator.alloc(size);
     }
 
     void RuntimeObj::deallocHost(void *ptr)
@@ -89,9 +219,9 @@ namespace infini
         CHECK_INFINI_ERROR(infinirtFreeHost(ptr));
     }
 
-    void RuntimeObj::deallocDevice(void *ptr)
+    void RuntimeObj::deallocDevice(void *ptr) const
     {
-        CHECK_INFINI_ERROR(infinirtFree(ptr));
+        allocator.free(ptr);
     }
 
     void RuntimeObj::memcpy(void *dst, const void *src, size_t size, infinirtMemcpyKind_t kind)
@@ -106,14 +236,14 @@ namespace infini
 
     void *RuntimeObj::mallocAsync(size_t size, infinirtStream_t stream)
     {
-        void *ptr = nullptr;
-        CHECK_INFINI_ERROR(infinirtMallocAsync(&ptr, size, stream));
-        return ptr;
+        // Blocks are cached per stream, so reuse on the same stream is
+        // naturally ordered after the previous user's work.
+        return allocator.alloc(size, stream);
     }
 
     void RuntimeObj::freeAsync(void *ptr, infinirtStream_t stream)
     {
-        CHECK_INFINI_ERROR(infinirtFreeAsync(ptr, stream));
+        allocator.free(ptr, stream);
     }
 
     void RuntimeObj::synchronize() const
@@ -121,20 +251,62 @@ namespace infini
         CHECK_INFINI_ERROR(infinirtDeviceSynchronize());
     }
 
+    void RuntimeObj::streamSynchronize(infinirtStream_t stream) const
+    {
+        CHECK_INFINI_ERROR(infinirtStreamSynchronize(stream));
+    }
+
+    void RuntimeObj::emptyCache()
+    {
+        allocator.emptyCache();
+    }
+
+    const CachingAllocator &RuntimeObj::getAllocator() const
+    {
+        return allocator;
+    }
+
+    void RuntimeObj::setMemoryBudget(size_t bytes)
+    {
+        memoryBudget = bytes;
+    }
+
+    size_t RuntimeObj::getMemoryBudget() const
+    {
+        return memoryBudget;
+    }
+
+    Autotuner &RuntimeObj::getAutotuner() const
+    {
+        return autotuner;
+    }
+
+    StagingPool &RuntimeObj::getStagingPool()
+    {
+        return stagingPool;
+    }
+
     void *RuntimeObj::getWorkspace(size_t size) const
     {
-        IT_ASSERT(size < getWorkspaceSize(), "Workspace size is too small");
-        return workspace;
+        reserveWorkspace(size);
+        return getCurrentThreadContext()->workspace;
     }
 
     size_t RuntimeObj::getWorkspaceSize() const
     {
-        return workspaceSize;
+        return getCurrentThreadContext()->workspaceSize;
     }
 
-    void RuntimeObj::allocworkspace()
+    void RuntimeObj::reserveWorkspace(size_t size) const
     {
-        workspaceSize = 7ll << 30;
-        workspace = allocDevice(workspaceSize);
+        auto context = getCurrentThreadContext();
+        if (size <= context->workspaceSize)
+            return;
+        // The old buffer goes back to this stream's cache, so it is only
+        // reused by work queued after the kernels still reading it.
+        if (context->workspace)
+            allocator.free(context->workspace);
+        context->workspace = allocator.alloc(size, context->stream);
+        context->workspaceSize = size;
     }
 } // namespace infini
@@ -0,0 +1,115 @@
+#include "core/staging_pool.h"
+
+namespace infini
+{
+    bool StagingPool::isReady(Buffer &buffer)
+    {
+        if (buffer.inUse)
+            return false;
+        if (buffer.event)
+        {
+            infinirtEventStatus_t status;
+            CHECK_INFINI_ERROR(infinirtEventQuery(buffer.event, &status));
+            if (status != INFINIRT_EVENT_COMPLETE)
+                return false;
+            CHECK_INFINI_ERROR(infinirtEventDestroy(buffer.event));
+            buffer.event = nullptr;
+        }
+        return true;
+    }
+
+    StagingPool::Buffer &StagingPool::find(void *ptr)
+    {
+        auto it = std::find_if(buffers.begin(), buffers.end(),
+                               [ptr](const Buffer &b)
+                               { return b.ptr == ptr; });
+        IT_ASSERT(it != buffers.end(), "Pointer is not a staging buffer");
+        return *it;
+    }
+
+    void *StagingPool::acquire(size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        // Best fit among ready buffers
+        Buffer *best = nullptr;
+        for (auto &buffer : buffers)
+        {
+            if (buffer.size >= size && (!best || buffer.size < best->size) &&
+                isReady(buffer))
+                best = &buffer;
+        }
+        if (best)
+        {
+            ++hits;
+            best->inUse = true;
+            return best->ptr;
+        }
+
+        ++misses;
+        size_t bufferSize = kMinBufferSize;
+        while (bufferSize < size)
+            bufferSize <<= 1;
+        void *ptr = nullptr;
+        CHECK_INFINI_ERROR(infinirtMallocHost(&ptr, bufferSize));
+        buffers.push_back({ptr, bufferSize, true});
+        return ptr;
+    }
+
+    void StagingPool::release(void *ptr)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        find(ptr).inUse = false;
+    }
+
+    void StagingPool::release(void *ptr, infinirtStream_t stream)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto &buffer = find(ptr);
+        IT_ASSERT(buffer.event == nullptr);
+        CHECK_INFINI_ERROR(infinirtEventCreate(&buffer.event));
+        CHECK_INFINI_ERROR(infinirtEventRecord(buffer.event, stream));
+        buffer.inUse = false;
+    }
+
+    void StagingPool::clear()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto it = buffers.begin(); it != buffers.end();)
+        {
+            if (it->inUse)
+            {
+                ++it;
+                continue;
+            }
+            if (it->event)
+            {
+                CHECK_INFINI_ERROR(infinirtEventSynchronize(it->event));
+                CHECK_INFINI_ERROR(infinirtEventDestroy(it->event));
+            }
+            CHECK_INFINI_ERROR(infinirtFreeHost(it->ptr));
+            it = buffers.erase(it);
+        }
+    }
+
+    size_t StagingPool::getHits() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return hits;
+    }
+
+    size_t StagingPool::getMisses() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return misses;
+    }
+
+    size_t StagingPool::getCachedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t bytes = 0;
+        for (auto &buffer : buffers)
+            bytes += buffer.size;
+        return bytes;
+    }
+
+} // namespace infini
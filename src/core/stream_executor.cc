@@ -0,0 +1,251 @@
+#include "core/stream_executor.h"
+
+namespace infini
+{
+    MultiStreamExecutor::MultiStreamExecutor(Runtime runtime_, size_t numStreams)
+        : runtime(std::move(runtime_)), numStreams(numStreams)
+    {
+        IT_ASSERT(numStreams > 0);
+        auto context = runtime->getCurrentThreadContext();
+        device = context->device;
+        deviceId = context->deviceId;
+        CHECK_INFINI_ERROR(infinirtEventCreate(&startEvent));
+        streamEvents.resize(numStreams);
+        for (auto &event : streamEvents)
+            CHECK_INFINI_ERROR(infinirtEventCreate(&event));
+
+        contexts.resize(numStreams);
+        for (size_t i = 0; i < numStreams; ++i)
+            workers.emplace_back([this, i]
+                                 {
+                                     workerLoop(i);
+                                     runtime->releaseThreadContext();
+                                 });
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]
+                { return std::all_of(contexts.begin(), contexts.end(),
+                                     [](const Context &ctx)
+                                     { return ctx != nullptr; }); });
+    }
+
+    MultiStreamExecutor::~MultiStreamExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+        for (auto &context : contexts)
+            infinirtStreamSynchronize(context->stream);
+        destroyEvents();
+        for (auto event : streamEvents)
+            infinirtEventDestroy(event);
+        infinirtEventDestroy(startEvent);
+    }
+
+    void MultiStreamExecutor::destroyEvents()
+    {
+        for (auto event : events)
+        {
+            if (event)
+                infinirtEventDestroy(event);
+        }
+        events.clear();
+    }
+
+    MultiStreamExecutor::Schedule
+    MultiStreamExecutor::buildSchedule(const OpVec &ops, size_t numStreams)
+    {
+        std::unordered_map<OperatorObj *, size_t> opIndex;
+        for (size_t i = 0; i < ops.size(); ++i)
+            opIndex[ops[i].get()] = i;
+
+        Schedule schedule;
+        schedule.streamOf.assign(ops.size(), -1);
+        schedule.streamOps.resize(numStreams);
+        schedule.waits.resize(ops.size());
+        schedule.recordEvent.assign(ops.size(), false);
+        vector<optional<size_t>> tail(numStreams);
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            vector<size_t> preds;
+            for (auto &pred : ops[i]->getPredecessors())
+            {
+                auto it = opIndex.find(pred.get());
+                if (it != opIndex.end())
+                    preds.push_back(it->second);
+            }
+            std::sort(preds.begin(), preds.end());
+
+            // Continue a chain if a predecessor is still the last op of its
+            // stream, otherwise branch off to the least loaded stream
+            int stream = -1;
+            for (auto pred : preds)
+            {
+                int s = schedule.streamOf[pred];
+                if (tail[s] == pred)
+                {
+                    stream = s;
+                    break;
+                }
+            }
+            if (stream < 0)
+            {
+                stream = 0;
+                for (size_t s = 1; s < numStreams; ++s)
+                {
+                    if (schedule.streamOps[s].size() < schedule.streamOps[stream].size())
+                        stream = s;
+                }
+            }
+            schedule.streamOf[i] = stream;
+            schedule.streamOps[stream].push_back(i);
+            tail[stream] = i;
+
+            for (auto pred : preds)
+            {
+                if (schedule.streamOf[pred] == stream)
+                    continue;
+                schedule.waits[i].push_back(pred);
+                schedule.recordEvent[pred] = true;
+                ++schedule.numCrossEdges;
+            }
+        }
+        return schedule;
+    }
+
+    const MultiStreamExecutor::Schedule &MultiStreamExecutor::getSchedule() const
+    {
+        return schedule;
+    }
+
+    void MultiStreamExecutor::rebuild(const Graph &graph_)
+    {
+        graph = graph_;
+        IT_ASSERT(graph->topo_sort(), "Graph has a cycle");
+        const auto &ops = graph->getOperators();
+        schedule = buildSchedule(ops, numStreams);
+        std::unordered_map<OperatorObj *, int> assignment;
+        for (size_t i = 0; i < ops.size(); ++i)
+            assignment[ops[i].get()] = schedule.streamOf[i];
+        if (assignment != graph->getStreamAssignment())
+        {
+            // The serial memory plan lets independent branches share buffers
+            graph->setStreamAssignment(std::move(assignment));
+            graph->dataMalloc();
+        }
+        runtime->prepare(graph);
+        plan = graph->getPlan();
+        destroyEvents();
+        size_t numOps = plan->records.size();
+        events.assign(numOps, nullptr);
+        for (size_t i = 0; i < numOps; ++i)
+        {
+            if (schedule.recordEvent[i])
+                CHECK_INFINI_ERROR(infinirtEventCreate(&events[i]));
+        }
+        recorded.reset(new std::atomic<uint64_t>[numOps]);
+        for (size_t i = 0; i < numOps; ++i)
+            recorded[i].store(0);
+    }
+
+    void MultiStreamExecutor::run(const Graph &graph_)
+    {
+        IT_ASSERT(!graph_->getOffloader(),
+                  "Multi-stream execution does not support host offload");
+        if (graph_ != graph || graph_->getPlan() != plan)
+            rebuild(graph_);
+        plan->refreshStaleData();
+
+        auto stream = runtime->getCurrentStream();
+        CHECK_INFINI_ERROR(infinirtEventRecord(startEvent, stream));
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ++generation;
+            finished = 0;
+            aborted = false;
+            error = nullptr;
+        }
+        cv.notify_all();
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]
+                { return finished == numStreams; });
+        if (error)
+            std::rethrow_exception(error);
+        // Later work on the caller's stream sees the results of all streams
+        for (auto event : streamEvents)
+            CHECK_INFINI_ERROR(infinirtStreamWaitEvent(stream, event));
+    }
+
+    void MultiStreamExecutor::workerLoop(size_t idx)
+    {
+        runtime->initThreadContext(device, deviceId);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            contexts[idx] = runtime->getCurrentThreadContext();
+        }
+        cv.notify_all();
+
+        uint64_t seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]
+                        { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+            }
+            try
+            {
+                runStream(idx, seen);
+            }
+            catch (...)
+            {
+                aborted = true;
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!error)
+                    error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                ++finished;
+            }
+            cv.notify_all();
+        }
+    }
+
+    void MultiStreamExecutor::runStream(size_t idx, uint64_t gen)
+    {
+        auto &context = contexts[idx];
+        auto stream = context->stream;
+        runtime->reserveWorkspace(plan->workspaceSize);
+        void *workspace = context->workspace;
+        CHECK_INFINI_ERROR(infinirtStreamWaitEvent(stream, startEvent));
+        for (auto i : schedule.streamOps[idx])
+        {
+            for (auto pred : schedule.waits[i])
+            {
+                // The event must be recorded before this stream waits on it
+                while (recorded[pred].load(std::memory_order_acquire) != gen)
+                {
+                    IT_ASSERT(!aborted, "Another stream failed");
+                    std::this_thread::yield();
+                }
+                CHECK_INFINI_ERROR(infinirtStreamWaitEvent(stream, events[pred]));
+            }
+            const auto &record = plan->records[i];
+            record.kernel->launch(record, workspace, stream, runtime.get());
+            if (schedule.recordEvent[i])
+            {
+                CHECK_INFINI_ERROR(infinirtEventRecord(events[i], stream));
+                recorded[i].store(gen, std::memory_order_release);
+            }
+        }
+        CHECK_INFINI_ERROR(infinirtEventRecord(streamEvents[idx], stream));
+    }
+
+} // namespace infini
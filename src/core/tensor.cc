@@ -8,6 +8,31 @@
 
 namespace infini
 {
+    namespace
+    {
+        // Calls fn(i, offset) for element i, in row-major order of `shape`,
+        // stored `offset` elements past the start of the storage
+        template <typename F>
+        void forEachElement(const Shape &shape, const Stride &stride, F &&fn)
+        {
+            size_t count = std::accumulate(shape.begin(), shape.end(), size_t(1),
+                                           std::multiplies{});
+            vector<size_t> index(shape.size(), 0);
+            size_t offset = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                fn(i, offset);
+                for (size_t d = shape.size(); d > 0; --d)
+                {
+                    offset += stride[d - 1];
+                    if (++index[d - 1] < shape[d - 1])
+                        break;
+                    offset -= stride[d - 1] * shape[d - 1];
+                    index[d - 1] = 0;
+                }
+            }
+        }
+    } // namespace
 
     TensorObj::TensorObj(Shape shape_, DataType dtype)
         : dtype(dtype), shape(std::move(shape_)),
@@ -39,13 +64,186 @@ namespace infini
     void TensorObj::setData(void *data_)
     {
         IT_ASSERT(data != nullptr);
-        data = std::make_shared<BlobObj>(data_);
+        bindExternal(data_);
+    }
+
+    void TensorObj::bindExternal(void *ptr, MemoryLocation location)
+    {
+        IT_ASSERT(ptr != nullptr);
+        data = make_ref<BlobObj>(ptr, location);
+    }
+
+    void TensorObj::attachBlob(Blob blob)
+    {
+        IT_ASSERT(blob != nullptr);
+        data = std::move(blob);
+    }
+
+    bool TensorObj::isExternal() const
+    {
+        return data != nullptr && data->isExternal();
     }
 
     void TensorObj::dataMalloc(const Runtime &runtime)
     {
         IT_ASSERT(data == nullptr);
-        data = make_ref<BlobObj>(runtime->allocDevice(getTotalBytes()));
+        data = make_ref<BlobObj>(runtime, runtime->allocDevice(getTotalBytes()),
+                                 runtime->getCurrentStream());
+    }
+
+    Tensor TensorObj::view(Shape shape_, Stride stride_, size_t offset) const
+    {
+        IT_ASSERT(data != nullptr, "View of a tensor without storage");
+        IT_ASSERT(std::all_of(stride.begin(), stride.end(),
+                              [](StrideElem s) { return s >= 0; }),
+                  "Views of negatively strided tensors are not supported");
+        auto ret = make_ref<TensorObj>(std::move(shape_), std::move(stride_), dtype);
+        IT_ASSERT(std::all_of(ret->stride.begin(), ret->stride.end(),
+                              [](StrideElem s) { return s >= 0; }));
+        IT_ASSERT(offset + ret->getStorageSize() <= getStorageSize(),
+                  "View exceeds the storage of tensor " + std::to_string(guid));
+        ret->data = offset == 0 ? data
+                                : make_ref<BlobObj>(data, offset * dtype.getSize());
+        ret->weight = weight;
+        return ret;
+    }
+
+    Tensor TensorObj::transpose(const vector<int> &perm) const
+    {
+        IT_ASSERT(perm.size() == getRank());
+        Shape shape_(getRank());
+        Stride stride_(getRank());
+        vector<bool> seen(getRank(), false);
+        for (size_t i = 0; i < perm.size(); ++i)
+        {
+            IT_ASSERT(perm[i] >= 0 && size_t(perm[i]) < getRank() && !seen[perm[i]],
+                      "Invalid permutation " + vecToString(perm));
+            seen[perm[i]] = true;
+            shape_[i] = shape[perm[i]];
+            stride_[i] = stride[perm[i]];
+        }
+        return view(std::move(shape_), std::move(stride_));
+    }
+
+    Tensor TensorObj::slice(int axis, size_t begin, size_t end) const
+    {
+        if (axis < 0)
+            axis += int(getRank());
+        IT_ASSERT(axis >= 0 && size_t(axis) < getRank());
+        IT_ASSERT(begin < end && end <= shape[axis]);
+        auto shape_ = shape;
+        shape_[axis] = end - begin;
+        return view(std::move(shape_), stride, begin * stride[axis]);
+    }
+
+    Tensor TensorObj::reshape(Shape shape_) const
+    {
+        IT_ASSERT(isContiguous(), "Reshape of a non-contiguous tensor");
+        auto ret = make_ref<TensorObj>(std::move(shape_), dtype);
+        IT_ASSERT(ret->getElement() == getElement());
+        return view(ret->shape, ret->stride);
+    }
+
+    bool TensorObj::isContiguous() const
+    {
+        // Dims of size 1 place no constraint on their stride
+        StrideElem expected = 1;
+        for (size_t i = getRank(); i > 0; --i)
+        {
+            if (shape[i - 1] != 1 && stride[i - 1] != expected)
+                return false;
+            expected *= shape[i - 1];
+        }
+        return true;
+    }
+
+    void TensorObj::copyFromHost(const Runtime &runtime, const void *src)
+    {
+        IT_ASSERT(data != nullptr);
+        ++hostWrites;
+        size_t bytes = getTotalBytes();
+        auto &pool = runtime->getStagingPool();
+        void *staging = pool.acquire(bytes);
+        if (isContiguous())
+        {
+            std::memcpy(staging, src, bytes);
+        }
+        else
+        {
+            // Elements between those of the view keep their values
+            if (auto stream = runtime->getCurrentStream())
+                runtime->streamSynchronize(stream);
+            runtime->memcpy(staging, data->getPtr<void *>(), bytes, dataToHost());
+            size_t size = dtype.getSize();
+            forEachElement(shape, stride, [&](size_t i, size_t offset)
+                           { std::memcpy(static_cast<char *>(staging) + offset * size,
+                                         static_cast<const char *>(src) + i * size, size); });
+        }
+        runtime->memcpy(data->getPtr<void *>(), staging, bytes, hostToData());
+        pool.release(staging);
+    }
+
+    void TensorObj::copyFromHostAsync(const Runtime &runtime, const void *src)
+    {
+        IT_ASSERT(data != nullptr);
+        IT_ASSERT(isContiguous(), "Asynchronous copy into a non-contiguous tensor");
+        ++hostWrites;
+        size_t bytes = getTotalBytes();
+        auto stream = runtime->getCurrentThreadContext()->stream;
+        auto &pool = runtime->getStagingPool();
+        void *staging = pool.acquire(bytes);
+        std::memcpy(staging, src, bytes);
+        runtime->memcpyAsync(data->getPtr<void *>(), staging, bytes,
+                             hostToData(), stream);
+        pool.release(staging, stream);
+    }
+
+    size_t TensorObj::getHostWrites() const { return hostWrites; }
+
+    void TensorObj::copyToHost(const Runtime &runtime, void *dst) const
+    {
+        IT_ASSERT(data != nullptr);
+        size_t bytes = getTotalBytes();
+        // Wait for kernels still writing this tensor on the current stream
+        if (auto stream = runtime->getCurrentStream())
+            runtime->streamSynchronize(stream);
+        auto &pool = runtime->getStagingPool();
+        void *staging = pool.acquire(bytes);
+        runtime->memcpy(staging, data->getPtr<void *>(), bytes, dataToHost());
+        if (isContiguous())
+        {
+            std::memcpy(dst, staging, bytes);
+        }
+        else
+        {
+            size_t size = dtype.getSize();
+            forEachElement(shape, stride, [&](size_t i, size_t offset)
+                           { std::memcpy(static_cast<char *>(dst) + i * size,
+                                         static_cast<const char *>(staging) + offset * size,
+                                         size); });
+        }
+        pool.release(staging);
+    }
+
+    void TensorObj::copyToHostAsync(const Runtime &runtime, void *dst) const
+    {
+        IT_ASSERT(data != nullptr);
+        IT_ASSERT(isContiguous(), "Asynchronous copy from a non-contiguous tensor");
+        runtime->memcpyAsync(dst, data->getPtr<void *>(), getTotalBytes(),
+                             dataToHost(),
+                             runtime->getCurrentThreadContext()->stream);
+    }
+
+    infinirtMemcpyKind_t TensorObj::hostToData() const
+    {
+        return data->getLocation() == MemoryLocation::Host ? INFINIRT_MEMCPY_H2H
+                                                           : INFINIRT_MEMCPY_H2D;
+    }
+
+    infinirtMemcpyKind_t TensorObj::dataToHost() const
+    {
+        return data->getLocation() == MemoryLocation::Host ? INFINIRT_MEMCPY_H2H
+                                                           : INFINIRT_MEMCPY_D2H;
     }
 
     ElementType TensorObj::getElement() const
@@ -91,6 +289,10 @@ namespace infini
 
     Operator TensorObj::getSource() const { return source.lock(); }
 
+    bool TensorObj::isWeight() const { return weight; }
+
+    void TensorObj::setWeight(bool weight_) { weight = weight_; }
+
     string TensorObj::toString() const
     {
         // Convert data pointer to string
@@ -172,8 +374,11 @@ namespace infini
     void TensorObj::printDataImpl(const Runtime &runtime, size_t maxElements, int precision) const
     {
         IT_ASSERT(data != nullptr);
-        void *data_ptr = runtime->allocHost(getTotalBytes());
-        runtime->memcpy(data_ptr, data->getPtr<void *>(), getTotalBytes(), INFINIRT_MEMCPY_D2H);
+        if (auto stream = runtime->getCurrentStream())
+            runtime->streamSynchronize(stream);
+        auto &pool = runtime->getStagingPool();
+        void *data_ptr = pool.acquire(getTotalBytes());
+        runtime->memcpy(data_ptr, data->getPtr<void *>(), getTotalBytes(), dataToHost());
         size_t totalElements = getElement();
         if (maxElements == 0)
         {
@@ -208,7 +413,7 @@ namespace infini
             std::cout << ", ... (" << totalElements - printCount << " more)";
         }
         std::cout << "]" << std::endl;
-        runtime->deallocHost(data_ptr);
+        pool.release(data_ptr);
     }
 
     template void TensorObj::printDataImpl<float>(const Runtime &, size_t, int) const;
@@ -0,0 +1,269 @@
+#include "core/tensor_parallel.h"
+#include "operators/Collective.h"
+#include "operators/Gemm.h"
+
+namespace infini
+{
+    namespace
+    {
+        // Part `part` of `parts` equal slices of a contiguous host tensor along `axis`
+        vector<uint8_t> sliceHost(const vector<uint8_t> &src, const Shape &shape,
+                                  int axis, int part, int parts)
+        {
+            size_t outer = 1;
+            for (int i = 0; i < axis; ++i)
+                outer *= shape[i];
+            size_t inner = src.size() / outer / parts;
+            vector<uint8_t> dst(inner * outer);
+            for (size_t o = 0; o < outer; ++o)
+                std::memcpy(dst.data() + o * inner,
+                            src.data() + (o * parts + part) * inner, inner);
+            return dst;
+        }
+    } // namespace
+
+    TensorParallelExecutor::TensorParallelExecutor(Runtime runtime_, const Graph &graph,
+                                                   Config config_)
+        : runtime(std::move(runtime_)), config(std::move(config_))
+    {
+        IT_ASSERT(config.worldSize > 0);
+        if (config.comms.empty())
+            config.comms = SharedMemoryCommunicator::createGroup(config.worldSize);
+        IT_ASSERT(int(config.comms.size()) == config.worldSize);
+        IT_ASSERT(graph->topo_sort(), "Graph has a cycle");
+        for (int rank = 0; rank < config.worldSize; ++rank)
+        {
+            IT_ASSERT(config.comms[rank]->getRank() == rank);
+            ranks.push_back(std::make_unique<Rank>());
+            buildRank(graph, rank);
+        }
+
+        auto context = runtime->getCurrentThreadContext();
+        for (int rank = 0; rank < config.worldSize; ++rank)
+        {
+            ranks[rank]->thread = std::thread(
+                [this, rank, device = context->device, deviceId = context->deviceId]
+                {
+                    workerLoop(rank, device, deviceId);
+                    runtime->releaseThreadContext();
+                });
+        }
+        std::exception_ptr e;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]
+                    { return finished == config.worldSize; });
+            e = error;
+            stopping = e != nullptr;
+        }
+        if (e)
+        {
+            // The destructor does not run for a throwing constructor
+            cv.notify_all();
+            for (auto &rank : ranks)
+                rank->thread.join();
+            std::rethrow_exception(e);
+        }
+    }
+
+    TensorParallelExecutor::~TensorParallelExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &rank : ranks)
+        {
+            if (rank->thread.joinable())
+                rank->thread.join();
+        }
+    }
+
+    void TensorParallelExecutor::buildRank(const Graph &graph, int rank)
+    {
+        auto &state = *ranks[rank];
+        auto comm = config.comms[rank];
+        int parts = config.worldSize;
+        Graph g = make_ref<GraphObj>(runtime);
+        state.graph = g;
+        auto &mapped = state.tensors;
+
+        // Copy of `tensor` on this rank, holding slice `part` along `axis`
+        // of the original data when axis >= 0
+        auto addWeight = [&](const Tensor &tensor, int axis)
+        {
+            vector<uint8_t> host(tensor->getTotalBytes());
+            tensor->copyToHost(runtime, host.data());
+            Shape shape = tensor->getShape();
+            if (axis >= 0)
+            {
+                IT_ASSERT(shape[axis] % parts == 0,
+                          "Sharded dimension must be divisible by the world size");
+                host = sliceHost(host, shape, axis, rank, parts);
+                shape[axis] /= parts;
+            }
+            auto local = g->addTensor(shape, tensor->getDataType());
+            local->setWeight(tensor->isWeight());
+            local->dataMalloc(runtime);
+            local->copyFromHost(runtime, host.data());
+            return local;
+        };
+        auto get = [&](const Tensor &tensor)
+        {
+            auto it = mapped.find(tensor.get());
+            if (it != mapped.end())
+                return it->second;
+            IT_ASSERT(!tensor->getSource(), "Producer of a tensor was not visited");
+            auto local = tensor->isWeight() ? addWeight(tensor, -1)
+                                          : g->addTensor(tensor->getShape(),
+                                                         tensor->getDataType());
+            return mapped[tensor.get()] = local;
+        };
+
+        for (auto &op : graph->getOperators())
+        {
+            Tensor output;
+            switch (op->getOpType().underlying())
+            {
+            case OpType::Gemm:
+            {
+                auto gemm = as<GemmObj>(op);
+                auto A = op->getInput(0), B = op->getInput(1);
+                bool transA = gemm->getTransA(), transB = gemm->getTransB();
+                if (!B->isWeight() || B->getRank() != 2 || gemm->getBeta() != 0.0f ||
+                    gemm->getActivation().type != ActType::None)
+                {
+                    auto Y = g->addTensor(op->getOutput(0)->getShape(),
+                                          op->getOutput(0)->getDataType());
+                    TensorVec inputs;
+                    for (auto &input : op->getInputs())
+                        inputs.push_back(get(input));
+                    g->addOperator(op->clone(inputs, {Y}));
+                    output = Y;
+                    break;
+                }
+                if (rank == 0)
+                    ++numSharded;
+                if (config.mode == ShardMode::Column)
+                {
+                    auto localB = addWeight(B, transB ? 0 : 1);
+                    auto local = g->addOp<GemmObj>(get(A), localB, nullptr, nullptr,
+                                                   gemm->getAlpha(), 0.0f, transA, transB)
+                                     ->getOutput(0);
+                    output = g->addOp<AllGatherObj>(local, nullptr, comm, -1)->getOutput(0);
+                }
+                else
+                {
+                    auto localB = addWeight(B, transB ? 1 : 0);
+                    int axisA = transA ? int(A->getRank()) - 2 : int(A->getRank()) - 1;
+                    auto localA = g->addOp<SplitObj>(get(A), nullptr, axisA, rank, parts)
+                                      ->getOutput(0);
+                    auto partial = g->addOp<GemmObj>(localA, localB, nullptr, nullptr,
+                                                     gemm->getAlpha(), 0.0f, transA, transB)
+                                       ->getOutput(0);
+                    output = g->addOp<AllReduceSumObj>(partial, nullptr, comm)->getOutput(0);
+                }
+                break;
+            }
+            default:
+            {
+                // Replicated: the same op on this rank's copies
+                TensorVec inputs, outputs;
+                for (auto &input : op->getInputs())
+                    inputs.push_back(get(input));
+                for (auto &out : op->getOutputs())
+                {
+                    outputs.push_back(g->addTensor(out->getShape(), out->getDataType()));
+                    mapped[out.get()] = outputs.back();
+                }
+                g->addOperator(op->clone(inputs, outputs));
+                continue;
+            }
+            }
+            IT_ASSERT(output->getShape() == op->getOutput(0)->getShape());
+            mapped[op->getOutput(0).get()] = output;
+        }
+    }
+
+    void TensorParallelExecutor::workerLoop(int rank, infiniDevice_t device, int deviceId)
+    {
+        auto &state = *ranks[rank];
+        uint64_t seen = 0;
+        try
+        {
+            runtime->initThreadContext(device, deviceId);
+            state.graph->dataMalloc();
+            runtime->prepare(state.graph);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!error)
+                error = std::current_exception();
+        }
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                ++finished;
+                cv.notify_all();
+                cv.wait(lock, [&]
+                        { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+            }
+            try
+            {
+                for (auto &[tensor, data] : *inputs)
+                    state.tensors.at(tensor.get())->copyFromHost(runtime, data);
+                runtime->run(state.graph);
+                runtime->streamSynchronize(runtime->getCurrentStream());
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    }
+
+    void TensorParallelExecutor::run(const std::map<Tensor, const void *> &inputs_)
+    {
+        for (auto &[tensor, data] : inputs_)
+            IT_ASSERT(ranks[0]->tensors.count(tensor.get()), "Tensor is not in the graph");
+        std::unique_lock<std::mutex> lock(mtx);
+        inputs = &inputs_;
+        finished = 0;
+        ++generation;
+        cv.notify_all();
+        cv.wait(lock, [this]
+                { return finished == config.worldSize; });
+        inputs = nullptr;
+        if (error)
+        {
+            auto e = error;
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    void TensorParallelExecutor::getOutput(const Tensor &tensor, void *dst) const
+    {
+        auto &mapped = ranks[0]->tensors;
+        auto it = mapped.find(tensor.get());
+        IT_ASSERT(it != mapped.end(), "Tensor is not in the graph");
+        it->second->copyToHost(runtime, dst);
+    }
+
+    const Graph &TensorParallelExecutor::getRankGraph(int rank) const
+    {
+        IT_ASSERT(0 <= rank && rank < config.worldSize);
+        return ranks[rank]->graph;
+    }
+
+    size_t TensorParallelExecutor::getNumSharded() const { return numSharded; }
+
+} // namespace infini
@@ -0,0 +1,280 @@
+#include "core/work_stealing_executor.h"
+#include <chrono>
+#include <cstring>
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+namespace infini
+{
+    string WorkStealingExecutor::RunStats::toString() const
+    {
+        std::ostringstream oss;
+        oss << "WorkStealing(wall=" << wallMs << "ms, critical path="
+            << criticalPathMs << "ms, total op time=" << totalOpMs
+            << "ms, steals=" << steals << ")";
+        return oss.str();
+    }
+
+    WorkStealingExecutor::WorkStealingExecutor(Runtime runtime)
+        : WorkStealingExecutor(std::move(runtime), Config()) {}
+
+    WorkStealingExecutor::WorkStealingExecutor(Runtime runtime_, Config config_)
+        : runtime(std::move(runtime_)), config(std::move(config_))
+    {
+        IT_ASSERT(config.numThreads > 0);
+#ifdef __linux__
+        for (int cpu : config.cpus)
+            IT_ASSERT(cpu >= 0 && cpu < CPU_SETSIZE, "Invalid CPU id " + std::to_string(cpu));
+#endif
+        IT_ASSERT(runtime->getCurrentThreadContext()->device == INFINI_DEVICE_CPU,
+                  "Work-stealing execution is only available on CPU");
+        for (size_t i = 0; i < config.numThreads; ++i)
+            workers.push_back(std::make_unique<Worker>());
+        for (size_t i = 0; i < config.numThreads; ++i)
+            workers[i]->thread = std::thread([this, i]
+                                             {
+                                                 workerLoop(i);
+                                                 runtime->releaseThreadContext();
+                                             });
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]
+                { return idleWorkers == workers.size(); });
+        if (error)
+        {
+            // The destructor does not run for a throwing constructor
+            stopping = true;
+            lock.unlock();
+            cv.notify_all();
+            for (auto &worker : workers)
+                worker->thread.join();
+            std::rethrow_exception(error);
+        }
+    }
+
+    WorkStealingExecutor::~WorkStealingExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &worker : workers)
+            worker->thread.join();
+    }
+
+    const WorkStealingExecutor::RunStats &WorkStealingExecutor::getStats() const
+    {
+        return stats;
+    }
+
+    void WorkStealingExecutor::rebuild(const Graph &graph_)
+    {
+        graph = graph_;
+        IT_ASSERT(graph->topo_sort(), "Graph has a cycle");
+        const auto &ops = graph->getOperators();
+        // Any two ops without a path between them may run together, so
+        // buffers are only shared along data dependencies
+        std::unordered_map<OperatorObj *, int> assignment;
+        for (auto &op : ops)
+            assignment[op.get()] = -1;
+        if (assignment != graph->getStreamAssignment())
+        {
+            graph->setStreamAssignment(std::move(assignment));
+            graph->dataMalloc();
+        }
+        runtime->prepare(graph);
+        plan = graph->getPlan();
+
+        std::unordered_map<OperatorObj *, size_t> opIndex;
+        for (size_t i = 0; i < ops.size(); ++i)
+            opIndex[ops[i].get()] = i;
+        succs.assign(ops.size(), {});
+        preds.assign(ops.size(), {});
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            for (auto &succ : ops[i]->getSuccessors())
+            {
+                auto it = opIndex.find(succ.get());
+                if (it == opIndex.end())
+                    continue;
+                succs[i].push_back(it->second);
+                preds[it->second].push_back(i);
+            }
+        }
+        pending.reset(new std::atomic<size_t>[ops.size()]);
+        opMs.assign(ops.size(), 0);
+    }
+
+    void WorkStealingExecutor::run(const Graph &graph_)
+    {
+        IT_ASSERT(!graph_->getOffloader(),
+                  "Work-stealing execution does not support host offload");
+        if (graph_ != graph || graph_->getPlan() != plan)
+            rebuild(graph_);
+        plan->refreshStaleData();
+        size_t numOps = plan->records.size();
+        stats = RunStats();
+        if (numOps == 0)
+            return;
+        // Inputs written asynchronously must land before workers read them
+        runtime->streamSynchronize(runtime->getCurrentStream());
+
+        auto begin = std::chrono::steady_clock::now();
+        size_t next = 0;
+        for (size_t i = 0; i < numOps; ++i)
+        {
+            pending[i].store(preds[i].size(), std::memory_order_relaxed);
+            if (preds[i].empty())
+            {
+                auto &worker = *workers[next++ % workers.size()];
+                std::lock_guard<std::mutex> lock(worker.mtx);
+                worker.ready.push_back(i);
+            }
+        }
+        remaining.store(numOps);
+        steals.store(0);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            aborted = false;
+            error = nullptr;
+            idleWorkers = 0;
+            ++generation;
+        }
+        cv.notify_all();
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]
+                    { return idleWorkers == workers.size(); });
+        }
+        auto end = std::chrono::steady_clock::now();
+        for (auto &worker : workers)
+            worker->ready.clear();
+        if (error)
+            std::rethrow_exception(error);
+
+        stats.wallMs = std::chrono::duration<double, std::milli>(end - begin).count();
+        stats.steals = steals.load();
+        vector<double> finish(numOps, 0);
+        for (size_t i = 0; i < numOps; ++i)
+        {
+            double start = 0;
+            for (auto pred : preds[i])
+                start = std::max(start, finish[pred]);
+            finish[i] = start + opMs[i];
+            stats.criticalPathMs = std::max(stats.criticalPathMs, finish[i]);
+            stats.totalOpMs += opMs[i];
+        }
+    }
+
+    bool WorkStealingExecutor::popOrSteal(size_t idx, size_t &op)
+    {
+        {
+            auto &self = *workers[idx];
+            std::lock_guard<std::mutex> lock(self.mtx);
+            if (!self.ready.empty())
+            {
+                op = self.ready.back();
+                self.ready.pop_back();
+                return true;
+            }
+        }
+        for (size_t k = 1; k < workers.size(); ++k)
+        {
+            auto &victim = *workers[(idx + k) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mtx);
+            if (!victim.ready.empty())
+            {
+                op = victim.ready.front();
+                victim.ready.pop_front();
+                ++steals;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingExecutor::execute(size_t idx, size_t op)
+    {
+        auto &worker = *workers[idx];
+        const auto &record = plan->records[op];
+        runtime->reserveWorkspace(plan->workspaceSize);
+        auto begin = std::chrono::steady_clock::now();
+        record.kernel->launch(record, worker.context->workspace,
+                              worker.context->stream, runtime.get());
+        opMs[op] = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - begin)
+                       .count();
+        for (auto succ : succs[op])
+        {
+            if (pending[succ].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(worker.mtx);
+                worker.ready.push_back(succ);
+            }
+        }
+    }
+
+    void WorkStealingExecutor::workerLoop(size_t idx)
+    {
+#ifdef __linux__
+        if (!config.cpus.empty())
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            int cpu = config.cpus[idx % config.cpus.size()];
+            CPU_SET(cpu, &set);
+            int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (rc != 0)
+            {
+                // Reported by the constructor once every worker is up
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!error)
+                    error = std::make_exception_ptr(
+                        Exception("Failed to pin worker " + std::to_string(idx) +
+                                  " to CPU " + std::to_string(cpu) + ": " +
+                                  std::strerror(rc)));
+            }
+        }
+#endif
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        workers[idx]->context = runtime->getCurrentThreadContext();
+
+        uint64_t seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                ++idleWorkers;
+                cv.notify_all();
+                cv.wait(lock, [&]
+                        { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+            }
+            while (remaining.load(std::memory_order_acquire) > 0 && !aborted)
+            {
+                size_t op;
+                if (!popOrSteal(idx, op))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                try
+                {
+                    execute(idx, op);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if (!error)
+                        error = std::current_exception();
+                    aborted = true;
+                }
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+    }
+
+} // namespace infini
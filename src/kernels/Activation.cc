@@ -0,0 +1,31 @@
+#include "operators/Activation.h"
+#include "core/runtime.h"
+
+namespace infini
+{
+
+    // Relu and Clip share one kernel: the descriptor knows the activation
+    class ActivationOp : public Kernel
+    {
+        void compute(const Operator &op, const RuntimeObj *runtime) const override
+        {
+            auto desc = static_cast<ActivationDesc *>(op->getInfiniOpDesc(runtime));
+            size_t workspaceSize = desc->getWorkspaceSize();
+            desc->apply(runtime->getWorkspace(workspaceSize), workspaceSize,
+                        op->getOutput(0)->getRawDataPtr<void *>(),
+                        op->getInput(0)->getRawDataPtr<void *>(),
+                        runtime->getCurrentThreadContext()->stream);
+        }
+
+        void launch(const LaunchRecord &record, void *workspace,
+                    infinirtStream_t stream, const RuntimeObj *) const override
+        {
+            static_cast<const ActivationDesc *>(record.desc)
+                ->apply(workspace, record.workspaceSize, record.output(0),
+                        record.input(0), stream);
+        }
+    };
+
+    REGISTER_KERNEL_ALL_DEVICES(OpType::Relu, ActivationOp);
+    REGISTER_KERNEL_ALL_DEVICES(OpType::Clip, ActivationOp);
+} // namespace infini
@@ -0,0 +1,121 @@
+#include "operators/Collective.h"
+#include "core/runtime.h"
+
+namespace infini
+{
+    namespace
+    {
+        // Bytes of the dims before `axis` and from `axis` on of a contiguous tensor
+        pair<size_t, size_t> splitAt(const Tensor &tensor, int axis)
+        {
+            auto shape = tensor->getShape();
+            size_t outer = 1;
+            for (int i = 0; i < axis; ++i)
+                outer *= shape[i];
+            return {outer, tensor->getTotalBytes() / outer};
+        }
+    } // namespace
+
+    // The shared-memory communicator reads device buffers directly, so these
+    // kernels are registered for the CPU only.
+    class AllReduceSumCpu : public Kernel
+    {
+        static void allReduce(const AllReduceSumObj *op, void *y, const void *x,
+                              infinirtStream_t stream)
+        {
+            auto X = op->getInput(0);
+            if (y != x)
+                std::memcpy(y, x, X->getTotalBytes());
+            op->getCommunicator()->allReduceSum(y, X->getElement(), X->getDataType(),
+                                                stream);
+        }
+
+        void compute(const Operator &_op, const RuntimeObj *runtime) const override
+        {
+            auto op = as<AllReduceSumObj>(_op);
+            allReduce(op.get(), op->getOutput(0)->getRawDataPtr<void *>(),
+                      op->getInput(0)->getRawDataPtr<void *>(),
+                      runtime->getCurrentStream());
+        }
+
+        void launch(const LaunchRecord &record, void *, infinirtStream_t stream,
+                    const RuntimeObj *) const override
+        {
+            allReduce(static_cast<const AllReduceSumObj *>(record.op.get()),
+                      record.output(0), record.input(0), stream);
+        }
+    };
+
+    class AllGatherCpu : public Kernel
+    {
+        static void allGather(const AllGatherObj *op, void *y, const void *x,
+                              infinirtStream_t stream)
+        {
+            auto comm = op->getCommunicator();
+            auto X = op->getInput(0);
+            size_t bytes = X->getTotalBytes();
+            auto [outer, inner] = splitAt(X, op->getAxis());
+            if (outer == 1)
+            {
+                comm->allGather(x, y, bytes, stream);
+                return;
+            }
+            // Ranks arrive one after another; interleave their rows
+            int worldSize = comm->getWorldSize();
+            vector<uint8_t> gathered(bytes * worldSize);
+            comm->allGather(x, gathered.data(), bytes, stream);
+            auto dst = static_cast<uint8_t *>(y);
+            for (int r = 0; r < worldSize; ++r)
+            {
+                for (size_t o = 0; o < outer; ++o)
+                    std::memcpy(dst + (o * worldSize + r) * inner,
+                                gathered.data() + r * bytes + o * inner, inner);
+            }
+        }
+
+        void compute(const Operator &_op, const RuntimeObj *runtime) const override
+        {
+            auto op = as<AllGatherObj>(_op);
+            allGather(op.get(), op->getOutput(0)->getRawDataPtr<void *>(),
+                      op->getInput(0)->getRawDataPtr<void *>(),
+                      runtime->getCurrentStream());
+        }
+
+        void launch(const LaunchRecord &record, void *, infinirtStream_t stream,
+                    const RuntimeObj *) const override
+        {
+            allGather(static_cast<const AllGatherObj *>(record.op.get()),
+                      record.output(0), record.input(0), stream);
+        }
+    };
+
+    class SplitCpu : public Kernel
+    {
+        static void split(const SplitObj *op, void *y, const void *x)
+        {
+            auto [outer, inner] = splitAt(op->getOutput(0), op->getAxis());
+            auto src = static_cast<const uint8_t *>(x) + op->getRank() * inner;
+            auto dst = static_cast<uint8_t *>(y);
+            for (size_t o = 0; o < outer; ++o)
+                std::memcpy(dst + o * inner, src + o * inner * op->getParts(), inner);
+        }
+
+        void compute(const Operator &_op, const RuntimeObj *) const override
+        {
+            auto op = as<SplitObj>(_op);
+            split(op.get(), op->getOutput(0)->getRawDataPtr<void *>(),
+                  op->getInput(0)->getRawDataPtr<void *>());
+        }
+
+        void launch(const LaunchRecord &record, void *, infinirtStream_t,
+                    const RuntimeObj *) const override
+        {
+            split(static_cast<const SplitObj *>(record.op.get()), record.output(0),
+                  record.input(0));
+        }
+    };
+
+    REGISTER_KERNEL(INFINI_DEVICE_CPU, OpType::AllReduceSum, AllReduceSumCpu, "AllReduceSum_CPU");
+    REGISTER_KERNEL(INFINI_DEVICE_CPU, OpType::AllGather, AllGatherCpu, "AllGather_CPU");
+    REGISTER_KERNEL(INFINI_DEVICE_CPU, OpType::Split, SplitCpu, "Split_CPU");
+} // namespace infini
@@ -6,22 +6,47 @@ namespace infini
 
     class GemmOp : public Kernel
     {
+        // infiniop has no fused epilogue, so this takes up to three separate
+        // calls on the stream: a Rearrange copies the broadcast bias into Y,
+        // the Gemm accumulates the product onto it with beta, and the
+        // activation then rewrites Y in place. Y is written two or three
+        // times; only GemmCpu stores each element once.
+        static void gemm(const GemmObj *op, const GemmObj::Desc &desc, void *workspace,
+                         void *y, const void *a, const void *b, const void *c,
+                         infinirtStream_t stream)
+        {
+            if (desc.bias)
+            {
+                CHECK_INFINI_ERROR(infiniopRearrange(desc.bias, y, c, stream));
+            }
+            CHECK_INFINI_ERROR(infiniopGemm(
+                desc.gemm, workspace, desc.workspaceSize, y, a, b, op->getAlpha(),
+                op->getBeta(), stream));
+            if (desc.act)
+                desc.act->apply(workspace, desc.workspaceSize, y, y, stream);
+        }
+
         void compute(const Operator &_op,
                      const RuntimeObj *runtime) const override
         {
             auto op = as<GemmObj>(_op);
-            op->createOpDesc();
-            void *yData = (op->getOutput(0)->getRawDataPtr<void *>());
-            void *const aData = (op->getInput(0)->getRawDataPtr<void *>());
-            void *const bData = (op->getInput(1)->getRawDataPtr<void *>());
-            size_t workspace_size = 0;
-            CHECK_INFINI_ERROR(infiniopGetGemmWorkspaceSize(
-                (infiniopGemmDescriptor_t)op->getInfiniOpDesc(), &workspace_size));
-            void *workspace = runtime->getWorkspace(workspace_size);
-            CHECK_INFINI_ERROR(infiniopGemm(
-                (infiniopGemmDescriptor_t)op->getInfiniOpDesc(), workspace,
-                workspace_size, yData, aData, bData, op->getAlpha(), op->getBeta(),
-                runtime->getCurrentThreadContext()->stream));
+            auto desc = static_cast<GemmObj::Desc *>(op->getInfiniOpDesc(runtime));
+            auto bias = op->getBias();
+            gemm(op.get(), *desc, runtime->getWorkspace(desc->workspaceSize),
+                 op->getOutput(0)->getRawDataPtr<void *>(),
+                 op->getInput(0)->getRawDataPtr<void *>(),
+                 op->getInput(1)->getRawDataPtr<void *>(),
+                 bias ? bias->getRawDataPtr<void *>() : nullptr,
+                 runtime->getCurrentThreadContext()->stream);
+        }
+
+        void launch(const LaunchRecord &record, void *workspace,
+                    infinirtStream_t stream, const RuntimeObj *) const override
+        {
+            gemm(static_cast<const GemmObj *>(record.op.get()),
+                 *static_cast<const GemmObj::Desc *>(record.desc), workspace,
+                 record.output(0), record.input(0), record.input(1),
+                 record.numInputs > 2 ? record.input(2) : nullptr, stream);
         }
     };
 
@@ -0,0 +1,105 @@
+#include "operators/Gemm.h"
+#include "core/runtime.h"
+
+namespace infini
+{
+    // Plain host GEMM for small problems, where the infiniop call overhead
+    // dominates. Works on arbitrary strides, transposed operands included;
+    // batch dims of size 1 broadcast.
+    // Bias and activation are applied before each element is stored.
+    class GemmCpu : public Kernel
+    {
+        static constexpr size_t kMaxFlops = size_t(1) << 18; // m * n * k
+
+        static void gemm(const GemmObj *op, float *y, const float *a, const float *b,
+                         const float *c)
+        {
+            auto Y = op->getOutput(0);
+            auto [aShape, aStride] = op->getOperandLayout(0);
+            auto [bShape, bStride] = op->getOperandLayout(1);
+            auto yShape = Y->getShape();
+            auto yStride = Y->getStride();
+            size_t rank = yShape.size();
+            size_t m = yShape[rank - 2], n = yShape[rank - 1], k = aShape.back();
+            size_t batch = rank == 3 ? yShape[0] : 1;
+            auto batchStride = [](const Shape &shape, const Stride &stride)
+            {
+                return shape.size() == 3 && shape[0] > 1 ? stride[0] : 0;
+            };
+            ptrdiff_t aBatch = batchStride(aShape, aStride);
+            ptrdiff_t bBatch = batchStride(bShape, bStride);
+            ptrdiff_t yBatch = rank == 3 ? yStride[0] : 0;
+            ptrdiff_t aRow = aStride[aStride.size() - 2], aCol = aStride.back();
+            ptrdiff_t bRow = bStride[bStride.size() - 2], bCol = bStride.back();
+            ptrdiff_t yRow = yStride[rank - 2], yCol = yStride[rank - 1];
+            float alpha = op->getAlpha(), beta = op->getBeta();
+            const auto &act = op->getActivation();
+            Stride cStride = c ? op->getBiasStride() : Stride(rank, 0);
+            ptrdiff_t cBatch = rank == 3 ? cStride[0] : 0;
+            ptrdiff_t cRow = cStride[rank - 2], cCol = cStride[rank - 1];
+            vector<float> acc(n);
+            for (size_t t = 0; t < batch; ++t)
+            {
+                for (size_t i = 0; i < m; ++i)
+                {
+                    std::fill(acc.begin(), acc.end(), 0.0f);
+                    const float *aRowPtr = a + t * aBatch + i * aRow;
+                    for (size_t p = 0; p < k; ++p)
+                    {
+                        float av = aRowPtr[p * aCol];
+                        const float *bRowPtr = b + t * bBatch + p * bRow;
+                        for (size_t j = 0; j < n; ++j)
+                            acc[j] += av * bRowPtr[j * bCol];
+                    }
+                    float *yRowPtr = y + t * yBatch + i * yRow;
+                    // Without a bias, beta scales what Y held before
+                    const float *prevPtr = c ? c + t * cBatch + i * cRow : yRowPtr;
+                    ptrdiff_t prevCol = c ? cCol : yCol;
+                    for (size_t j = 0; j < n; ++j)
+                    {
+                        float prev = beta == 0.0f ? 0.0f : beta * prevPtr[j * prevCol];
+                        yRowPtr[j * yCol] = act.apply(alpha * acc[j] + prev);
+                    }
+                }
+            }
+        }
+
+        bool isApplicable(const Operator &_op) const override
+        {
+            auto op = as<GemmObj>(_op);
+            auto tensors = op->getInputs();
+            tensors.push_back(op->getOutput(0));
+            for (auto &tensor : tensors)
+            {
+                if (tensor->getDataType().getType() != INFINI_DTYPE_F32)
+                    return false;
+            }
+            size_t k = op->getOperandLayout(0).first.back();
+            size_t flops = op->getOutput(0)->getElement() * k;
+            return flops <= kMaxFlops;
+        }
+
+        void compute(const Operator &_op, const RuntimeObj *) const override
+        {
+            auto op = as<GemmObj>(_op);
+            auto bias = op->getBias();
+            gemm(op.get(), op->getOutput(0)->getRawDataPtr<float *>(),
+                 op->getInput(0)->getRawDataPtr<float *>(),
+                 op->getInput(1)->getRawDataPtr<float *>(),
+                 bias ? bias->getRawDataPtr<float *>() : nullptr);
+        }
+
+        void launch(const LaunchRecord &record, void *, infinirtStream_t,
+                    const RuntimeObj *) const override
+        {
+            gemm(static_cast<const GemmObj *>(record.op.get()),
+                 static_cast<float *>(record.output(0)),
+                 static_cast<const float *>(record.input(0)),
+                 static_cast<const float *>(record.input(1)),
+                 record.numInputs > 2 ? static_cast<const float *>(record.input(2))
+                                      : nullptr);
+        }
+    };
+
+    REGISTER_KERNEL_VARIANT(INFINI_DEVICE_CPU, OpType::Gemm, GemmCpu, "GemmCpu", 1);
+} // namespace infini
@@ -10,19 +10,26 @@ namespace infini
                      const RuntimeObj *runtime) const override
         {
             auto op = as<RMSNormObj>(_op);
-            op->createOpDesc();
+            auto desc = (infiniopRMSNormDescriptor_t)op->getInfiniOpDesc(runtime);
             void *yData = (op->getOutput(0)->getRawDataPtr<void *>());
             void *const xData = (op->getInput(0)->getRawDataPtr<void *>());
             void *const wData = (op->getInput(1)->getRawDataPtr<void *>());
             size_t workspace_size = 0;
-            CHECK_INFINI_ERROR(infiniopGetRMSNormWorkspaceSize(
-                (infiniopRMSNormDescriptor_t)op->getInfiniOpDesc(), &workspace_size));
+            CHECK_INFINI_ERROR(infiniopGetRMSNormWorkspaceSize(desc, &workspace_size));
             void *workspace = runtime->getWorkspace(workspace_size);
             CHECK_INFINI_ERROR(infiniopRMSNorm(
-                (infiniopRMSNormDescriptor_t)op->getInfiniOpDesc(), workspace,
-                workspace_size, yData, xData, wData,
+                desc, workspace, workspace_size, yData, xData, wData,
                 runtime->getCurrentThreadContext()->stream));
         }
+
+        void launch(const LaunchRecord &record, void *workspace,
+                    infinirtStream_t stream, const RuntimeObj *) const override
+        {
+            CHECK_INFINI_ERROR(infiniopRMSNorm(
+                (infiniopRMSNormDescriptor_t)record.desc, workspace,
+                record.workspaceSize, record.output(0), record.input(0),
+                record.input(1), stream));
+        }
     };
 
     REGISTER_KERNEL_ALL_DEVICES(OpType::RMSNorm, RMSNormOp);
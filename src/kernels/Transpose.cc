@@ -0,0 +1,29 @@
+#include "operators/Transpose.h"
+#include "core/runtime.h"
+
+namespace infini
+{
+
+    class TransposeOp : public Kernel
+    {
+        void compute(const Operator &_op,
+                     const RuntimeObj *runtime) const override
+        {
+            auto op = as<TransposeObj>(_op);
+            auto desc = (infiniopRearrangeDescriptor_t)op->getInfiniOpDesc(runtime);
+            CHECK_INFINI_ERROR(infiniopRearrange(
+                desc, op->getOutput(0)->getRawDataPtr<void *>(),
+                op->getInput(0)->getRawDataPtr<void *>(),
+                runtime->getCurrentThreadContext()->stream));
+        }
+
+        void launch(const LaunchRecord &record, void *, infinirtStream_t stream,
+                    const RuntimeObj *) const override
+        {
+            CHECK_INFINI_ERROR(infiniopRearrange((infiniopRearrangeDescriptor_t)record.desc,
+                                                 record.output(0), record.input(0), stream));
+        }
+    };
+
+    REGISTER_KERNEL_ALL_DEVICES(OpType::Transpose, TransposeOp);
+} // namespace infini
@@ -0,0 +1,213 @@
+#include "operators/Activation.h"
+#include "core/runtime.h"
+
+namespace infini
+{
+    namespace
+    {
+        infiniopTensorDescriptor_t createTensorDesc(const Shape &shape, const Stride &stride,
+                                                    infiniDtype_t dtype)
+        {
+            infiniopTensorDescriptor_t desc = nullptr;
+            CHECK_INFINI_ERROR(infiniopCreateTensorDescriptor(
+                &desc, shape.size(), shape.data(), stride.data(), dtype));
+            return desc;
+        }
+    } // namespace
+
+    string Activation::toString() const
+    {
+        switch (type)
+        {
+        case ActType::Relu:
+            return "Relu";
+        case ActType::Clip:
+            return "Clip[" + std::to_string(min) + "," + std::to_string(max) + "]";
+        default:
+            return "None";
+        }
+    }
+
+    ActivationDesc::ActivationDesc(infiniopHandle_t handle, const Activation &act_,
+                                   const Tensor &y, const Tensor &x)
+        : act(act_)
+    {
+        auto dtype = y->getDataType().getType();
+        auto yTensor = createTensorDesc(y->getShape(), y->getStride(), dtype);
+        auto xTensor = createTensorDesc(x->getShape(), x->getStride(), dtype);
+        if (act.type == ActType::Relu)
+        {
+            CHECK_INFINI_ERROR(infiniopCreateReluDescriptor(handle, &relu, yTensor, xTensor));
+            CHECK_INFINI_ERROR(infiniopGetReluWorkspaceSize(relu, &workspaceSize));
+        }
+        else if (act.type == ActType::Clip)
+        {
+            IT_ASSERT(dtype == INFINI_DTYPE_F32 || dtype == INFINI_DTYPE_F64,
+                      "Clip bounds are only supported for F32 and F64");
+            // Bounds are scalars broadcast over y
+            boundBytes = y->getDataType().getSize();
+            char host[2 * sizeof(double)];
+            if (dtype == INFINI_DTYPE_F32)
+            {
+                float values[2] = {act.min, act.max};
+                std::memcpy(host, values, sizeof(values));
+            }
+            else
+            {
+                double values[2] = {act.min, act.max};
+                std::memcpy(host, values, sizeof(values));
+            }
+            CHECK_INFINI_ERROR(infinirtMalloc(&bounds, 2 * boundBytes));
+            CHECK_INFINI_ERROR(infinirtMemcpy(bounds, host, 2 * boundBytes,
+                                              INFINIRT_MEMCPY_H2D));
+            auto boundTensor = createTensorDesc(y->getShape(),
+                                                Stride(y->getRank(), 0), dtype);
+            CHECK_INFINI_ERROR(infiniopCreateClipDescriptor(
+                handle, &clip, yTensor, xTensor, boundTensor, boundTensor));
+            CHECK_INFINI_ERROR(infiniopGetClipWorkspaceSize(clip, &workspaceSize));
+            CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(boundTensor));
+        }
+        CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(yTensor));
+        CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(xTensor));
+    }
+
+    ActivationDesc::~ActivationDesc()
+    {
+        infiniStatus_t err = INFINI_STATUS_SUCCESS;
+        if (relu)
+            err = infiniopDestroyReluDescriptor(relu);
+        if (clip)
+            err = infiniopDestroyClipDescriptor(clip);
+        if (bounds)
+            infinirtFree(bounds);
+        if (err != INFINI_STATUS_SUCCESS)
+        {
+            std::cerr << "Warning: " << act.toString()
+                      << " descriptor destroy failed with error code " << err << std::endl;
+        }
+    }
+
+    size_t ActivationDesc::getWorkspaceSize() const { return workspaceSize; }
+
+    void ActivationDesc::apply(void *workspace, size_t size, void *y, const void *x,
+                               infinirtStream_t stream) const
+    {
+        if (relu)
+        {
+            CHECK_INFINI_ERROR(infiniopRelu(relu, workspace, size, y, x, stream));
+        }
+        else if (clip)
+        {
+            CHECK_INFINI_ERROR(infiniopClip(clip, workspace, size, y, x, bounds,
+                                            static_cast<char *>(bounds) + boundBytes,
+                                            stream));
+        }
+    }
+
+    ReluObj::ReluObj(GraphObj *graph, Tensor X, Tensor Y)
+        : OperatorObj(OpType::Relu, {X}, {Y})
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    ReluObj::ReluObj(Unchecked, Tensor X, Tensor Y)
+        : OperatorObj(OpType::Relu, {X}, {Y}) {}
+
+    string ReluObj::toString() const
+    {
+        std::ostringstream os;
+        os << "Relu( X=" << inputs[0]->getGuid() << ",Y=" << outputs[0]->getGuid()
+           << " )";
+        return os.str();
+    }
+
+    Operator ReluObj::clone(const TensorVec &inputs_, const TensorVec &outputs_) const
+    {
+        return make_ref<ReluObj>(Unchecked{}, inputs_[0], outputs_[0]);
+    }
+
+    bool ReluObj::addAttrs(DescriptorKey &) const { return true; }
+
+    Ref<void> ReluObj::createOpDesc(infiniopHandle_t handle)
+    {
+        return make_ref<ActivationDesc>(handle, Activation{ActType::Relu}, outputs[0],
+                                        inputs[0]);
+    }
+
+    size_t ReluObj::getWorkspaceSize(const RuntimeObj *runtime)
+    {
+        return static_cast<ActivationDesc *>(getInfiniOpDesc(runtime))->getWorkspaceSize();
+    }
+
+    vector<pair<int, int>> ReluObj::getInplacePairs() const { return {{0, 0}}; }
+
+    optional<vector<Shape>> ReluObj::inferShape() { return {{inputs[0]->getShape()}}; }
+
+    vector<DataType> ReluObj::inferDataType() const { return {inputs[0]->getDataType()}; }
+
+    ClipObj::ClipObj(GraphObj *graph, Tensor X, Tensor Y, float min, float max)
+        : OperatorObj(OpType::Clip, {X}, {Y}), min(min), max(max)
+    {
+        IT_ASSERT(min <= max);
+        IT_ASSERT(checkValid(graph));
+    }
+
+    ClipObj::ClipObj(Unchecked, Tensor X, Tensor Y, float min, float max)
+        : OperatorObj(OpType::Clip, {X}, {Y}), min(min), max(max) {}
+
+    string ClipObj::toString() const
+    {
+        std::ostringstream os;
+        os << "Clip( X=" << inputs[0]->getGuid() << ",Y=" << outputs[0]->getGuid()
+           << ",min=" << min << ",max=" << max << " )";
+        return os.str();
+    }
+
+    Operator ClipObj::clone(const TensorVec &inputs_, const TensorVec &outputs_) const
+    {
+        return make_ref<ClipObj>(Unchecked{}, inputs_[0], outputs_[0], min, max);
+    }
+
+    bool ClipObj::addAttrs(DescriptorKey &key) const
+    {
+        key.add(min).add(max);
+        return true;
+    }
+
+    Ref<void> ClipObj::createOpDesc(infiniopHandle_t handle)
+    {
+        return make_ref<ActivationDesc>(handle, Activation{ActType::Clip, min, max},
+                                        outputs[0], inputs[0]);
+    }
+
+    size_t ClipObj::getWorkspaceSize(const RuntimeObj *runtime)
+    {
+        return static_cast<ActivationDesc *>(getInfiniOpDesc(runtime))->getWorkspaceSize();
+    }
+
+    vector<pair<int, int>> ClipObj::getInplacePairs() const { return {{0, 0}}; }
+
+    optional<vector<Shape>> ClipObj::inferShape() { return {{inputs[0]->getShape()}}; }
+
+    vector<DataType> ClipObj::inferDataType() const { return {inputs[0]->getDataType()}; }
+
+    void ClipObj::addDescAttrs(DescriptorKey &key) const { key.add(min).add(max); }
+
+    float ClipObj::getMin() const { return min; }
+
+    float ClipObj::getMax() const { return max; }
+
+    Activation getActivation(const Operator &op)
+    {
+        if (op->getOpType() == OpType::Relu)
+            return {ActType::Relu};
+        if (op->getOpType() == OpType::Clip)
+        {
+            auto clip = as<ClipObj>(op);
+            return {ActType::Clip, clip->getMin(), clip->getMax()};
+        }
+        IT_TODO_HALT_MSG(string("No activation for ") + op->getOpType().toString());
+        return {};
+    }
+
+} // namespace infini
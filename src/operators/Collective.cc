@@ -0,0 +1,140 @@
+#include "operators/Collective.h"
+
+namespace infini
+{
+    AllReduceSumObj::AllReduceSumObj(GraphObj *graph, Tensor X, Tensor Y,
+                                     Ref<Communicator> comm)
+        : OperatorObj(OpType::AllReduceSum, {X}, {Y}), comm(std::move(comm))
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    string AllReduceSumObj::toString() const
+    {
+        std::ostringstream os;
+        os << "AllReduceSum( X=" << inputs[0]->getGuid()
+           << ",Y=" << outputs[0]->getGuid()
+           << ",rank=" << comm->getRank() << "/" << comm->getWorldSize() << " )";
+        return os.str();
+    }
+
+    Operator AllReduceSumObj::clone(const TensorVec &inputs_,
+                                    const TensorVec &outputs_) const
+    {
+        return make_ref<AllReduceSumObj>(nullptr, inputs_[0], outputs_[0], comm);
+    }
+
+    // Collectives are carried out by the communicator, not by infiniop
+    Ref<void> AllReduceSumObj::createOpDesc(infiniopHandle_t) { return nullptr; }
+
+    optional<vector<Shape>> AllReduceSumObj::inferShape()
+    {
+        return {{inputs[0]->getShape()}};
+    }
+
+    vector<DataType> AllReduceSumObj::inferDataType() const
+    {
+        return {inputs[0]->getDataType()};
+    }
+
+    vector<pair<int, int>> AllReduceSumObj::getInplacePairs() const
+    {
+        return {{0, 0}};
+    }
+
+    const Ref<Communicator> &AllReduceSumObj::getCommunicator() const { return comm; }
+
+    AllGatherObj::AllGatherObj(GraphObj *graph, Tensor X, Tensor Y,
+                               Ref<Communicator> comm, int axis)
+        : OperatorObj(OpType::AllGather, {X}, {Y}), comm(std::move(comm)),
+          axis(axis < 0 ? axis + int(X->getRank()) : axis)
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    string AllGatherObj::toString() const
+    {
+        std::ostringstream os;
+        os << "AllGather( X=" << inputs[0]->getGuid()
+           << ",Y=" << outputs[0]->getGuid() << ",axis=" << axis
+           << ",rank=" << comm->getRank() << "/" << comm->getWorldSize() << " )";
+        return os.str();
+    }
+
+    Operator AllGatherObj::clone(const TensorVec &inputs_, const TensorVec &outputs_) const
+    {
+        return make_ref<AllGatherObj>(nullptr, inputs_[0], outputs_[0], comm, axis);
+    }
+
+    Ref<void> AllGatherObj::createOpDesc(infiniopHandle_t) { return nullptr; }
+
+    optional<vector<Shape>> AllGatherObj::inferShape()
+    {
+        auto shape = inputs[0]->getShape();
+        if (axis < 0 || axis >= int(shape.size()))
+            return std::nullopt;
+        shape[axis] *= comm->getWorldSize();
+        return {{shape}};
+    }
+
+    vector<DataType> AllGatherObj::inferDataType() const
+    {
+        return {inputs[0]->getDataType()};
+    }
+
+    const Ref<Communicator> &AllGatherObj::getCommunicator() const { return comm; }
+
+    int AllGatherObj::getAxis() const { return axis; }
+
+    SplitObj::SplitObj(GraphObj *graph, Tensor X, Tensor Y, int axis, int rank,
+                       int parts)
+        : OperatorObj(OpType::Split, {X}, {Y}),
+          axis(axis < 0 ? axis + int(X->getRank()) : axis), rank(rank), parts(parts)
+    {
+        IT_ASSERT(0 <= rank && rank < parts);
+        IT_ASSERT(checkValid(graph));
+    }
+
+    string SplitObj::toString() const
+    {
+        std::ostringstream os;
+        os << "Split( X=" << inputs[0]->getGuid()
+           << ",Y=" << outputs[0]->getGuid() << ",axis=" << axis
+           << ",part=" << rank << "/" << parts << " )";
+        return os.str();
+    }
+
+    Operator SplitObj::clone(const TensorVec &inputs_, const TensorVec &outputs_) const
+    {
+        return make_ref<SplitObj>(nullptr, inputs_[0], outputs_[0], axis, rank, parts);
+    }
+
+    bool SplitObj::addAttrs(DescriptorKey &key) const
+    {
+        key.add(axis).add(rank).add(parts);
+        return true;
+    }
+
+    Ref<void> SplitObj::createOpDesc(infiniopHandle_t) { return nullptr; }
+
+    optional<vector<Shape>> SplitObj::inferShape()
+    {
+        auto shape = inputs[0]->getShape();
+        if (axis < 0 || axis >= int(shape.size()) || shape[axis] % parts != 0)
+            return std::nullopt;
+        shape[axis] /= parts;
+        return {{shape}};
+    }
+
+    vector<DataType> SplitObj::inferDataType() const
+    {
+        return {inputs[0]->getDataType()};
+    }
+
+    int SplitObj::getAxis() const { return axis; }
+
+    int SplitObj::getRank() const { return rank; }
+
+    int SplitObj::getParts() const { return parts; }
+
+} // namespace infini
@@ -3,18 +3,48 @@
 namespace infini
 {
 
+    namespace
+    {
+        TensorVec gemmInputs(Tensor A, Tensor B, Tensor C)
+        {
+            TensorVec inputs{A, B};
+            if (C)
+                inputs.push_back(C);
+            return inputs;
+        }
+    } // namespace
+
+    GemmObj::Desc::~Desc()
+    {
+        infiniStatus_t err = INFINI_STATUS_SUCCESS;
+        if (gemm)
+            err = infiniopDestroyGemmDescriptor(gemm);
+        if (bias)
+        {
+            auto biasErr = infiniopDestroyRearrangeDescriptor(bias);
+            if (err == INFINI_STATUS_SUCCESS)
+                err = biasErr;
+        }
+        if (err != INFINI_STATUS_SUCCESS)
+        {
+            std::cerr << "Warning: Gemm descriptor destroy failed with error code "
+                      << err << std::endl;
+        }
+    }
+
     GemmObj::GemmObj(GraphObj *graph, Tensor A, Tensor B, Tensor Y, Tensor C,
                      float alpha, float beta, bool transA, bool transB)
-        : OperatorObj(OpType::Gemm, TensorVec{A, B}, {Y}), alpha(alpha), beta(beta),
+        : OperatorObj(OpType::Gemm, gemmInputs(A, B, C), {Y}), alpha(alpha), beta(beta),
           transA(transA), transB(transB)
     {
         IT_ASSERT(checkValid(graph));
-        if (C)
-        {
-            graph->getRuntime()->memcpy(Y->getRawDataPtr<void *>(), C->getRawDataPtr<void *>(), Y->getTotalBytes(), infinirtMemcpyKind_t::INFINIRT_MEMCPY_D2D);
-        }
     }
 
+    GemmObj::GemmObj(Unchecked, Tensor A, Tensor B, Tensor Y, Tensor C, float alpha,
+                     float beta, bool transA, bool transB, Activation act)
+        : OperatorObj(OpType::Gemm, gemmInputs(A, B, C), {Y}), alpha(alpha), beta(beta),
+          transA(transA), transB(transB), act(act) {}
+
     string GemmObj::toString() const
     {
         std::ostringstream os;
@@ -22,10 +52,30 @@ namespace infini
            << "],A=" << inputs[0]->getGuid() << ",B=" << inputs[1]->getGuid()
            << ",C="
            << (inputs.size() == 3 ? std::to_string(inputs[2]->getGuid()) : "null")
-           << ",Y=" << outputs[0]->getGuid() << " )";
+           << ",Y=" << outputs[0]->getGuid();
+        if (act.type != ActType::None)
+            os << ",act=" << act.toString();
+        os << " )";
         return os.str();
     }
 
+    Operator GemmObj::clone(const TensorVec &inputs_, const TensorVec &outputs_) const
+    {
+        return make_ref<GemmObj>(Unchecked{}, inputs_[0], inputs_[1], outputs_[0],
+                                 inputs_.size() > 2 ? inputs_[2] : nullptr, alpha, beta,
+                                 transA, transB, act);
+    }
+
+    bool GemmObj::addAttrs(DescriptorKey &key) const
+    {
+        // Without a bias beta scales what Y held before the run
+        if (beta != 0.0f && !getBias())
+            return false;
+        key.add(alpha).add(beta).add(transA).add(transB);
+        key.add(act.type).add(act.min).add(act.max);
+        return true;
+    }
+
     optional<vector<Shape>> GemmObj::inferShape()
     {
         auto A = inputs[0], B = inputs[1];
@@ -54,22 +104,34 @@ namespace infini
             ret = {batch, m, n}; // 3D
         else
             ret = {m, n}; // 2D
+        if (inputs.size() > 2)
+        {
+            // C broadcasts to Y along trailing dims
+            auto shapeC = inputs[2]->getShape();
+            if (shapeC.size() > ret.size())
+                return std::nullopt;
+            for (size_t i = 0; i < shapeC.size(); ++i)
+            {
+                auto dim = ret[ret.size() - shapeC.size() + i];
+                if (shapeC[i] != dim && shapeC[i] != 1)
+                    return std::nullopt;
+            }
+        }
         return {{ret}};
     }
 
     vector<DataType> GemmObj::inferDataType() const
     {
-        IT_ASSERT(inputs[0]->getDataType() == inputs[1]->getDataType());
+        for (auto &input : inputs)
+            IT_ASSERT(input->getDataType() == inputs[0]->getDataType());
         return {inputs[0]->getDataType()};
     }
 
-    void GemmObj::createOpDesc()
+    Ref<void> GemmObj::createOpDesc(infiniopHandle_t handle)
     {
-        auto aShape = inputs[0]->getShape();
-        auto bShape = inputs[1]->getShape();
+        auto [aShape, aStride] = getOperandLayout(0);
+        auto [bShape, bStride] = getOperandLayout(1);
         auto yShape = outputs[0]->getShape();
-        auto aStride = inputs[0]->getStride();
-        auto bStride = inputs[1]->getStride();
         auto yStride = outputs[0]->getStride();
         infiniopTensorDescriptor_t yTensor, aTensor, bTensor;
         CHECK_INFINI_ERROR(infiniopCreateTensorDescriptor(
@@ -81,21 +143,90 @@ namespace infini
         CHECK_INFINI_ERROR(infiniopCreateTensorDescriptor(
             &bTensor, bShape.size(), bShape.data(), bStride.data(),
             inputs[1]->getDataType().getType()));
-        infiniopHandle_t handle = nullptr;
-        CHECK_INFINI_ERROR(infiniopCreateHandle(&handle));
-        // create gemm op descriptor
+        auto desc = make_ref<Desc>();
         CHECK_INFINI_ERROR(infiniopCreateGemmDescriptor(
-            handle, (infiniopGemmDescriptor_t *)&infiniOpDesc, yTensor, aTensor,
+            handle, &desc->gemm, yTensor, aTensor,
             bTensor));
+        CHECK_INFINI_ERROR(infiniopGetGemmWorkspaceSize(desc->gemm, &desc->workspaceSize));
+        if (inputs.size() > 2)
+        {
+            // C is copied into Y first and scaled by beta during the product
+            auto cStride = getBiasStride();
+            infiniopTensorDescriptor_t cTensor;
+            CHECK_INFINI_ERROR(infiniopCreateTensorDescriptor(
+                &cTensor, yShape.size(), yShape.data(), cStride.data(),
+                inputs[2]->getDataType().getType()));
+            CHECK_INFINI_ERROR(infiniopCreateRearrangeDescriptor(handle, &desc->bias,
+                                                                 yTensor, cTensor));
+            CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(cTensor));
+        }
+        if (act.type != ActType::None)
+        {
+            desc->act = std::make_unique<ActivationDesc>(handle, act, outputs[0],
+                                                         outputs[0]);
+            desc->workspaceSize = std::max(desc->workspaceSize,
+                                           desc->act->getWorkspaceSize());
+        }
 
         CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(yTensor));
         CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(aTensor));
         CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(bTensor));
+        return desc;
+    }
+
+    void GemmObj::addDescAttrs(DescriptorKey &key) const
+    {
+        key.add(transA).add(transB).add(act.type).add(act.min).add(act.max);
     }
 
     bool GemmObj::getTransA() const { return transA; }
     bool GemmObj::getTransB() const { return transB; }
+    pair<Shape, Stride> GemmObj::getOperandLayout(int idx) const
+    {
+        IT_ASSERT(idx == 0 || idx == 1);
+        auto shape = inputs[idx]->getShape();
+        auto stride = inputs[idx]->getStride();
+        if (idx == 0 ? transA : transB)
+        {
+            size_t rank = shape.size();
+            std::swap(shape[rank - 2], shape[rank - 1]);
+            std::swap(stride[rank - 2], stride[rank - 1]);
+        }
+        return {shape, stride};
+    }
+
     float GemmObj::getAlpha() const { return alpha; }
     float GemmObj::getBeta() const { return beta; }
 
+    Tensor GemmObj::getBias() const { return inputs.size() > 2 ? inputs[2] : nullptr; }
+
+    Stride GemmObj::getBiasStride() const
+    {
+        IT_ASSERT(inputs.size() > 2);
+        auto shapeC = inputs[2]->getShape();
+        auto strideC = inputs[2]->getStride();
+        auto shapeY = outputs[0]->getShape();
+        Stride stride(shapeY.size(), 0);
+        size_t offset = shapeY.size() - shapeC.size();
+        for (size_t i = 0; i < shapeC.size(); ++i)
+        {
+            if (shapeC[i] == shapeY[offset + i])
+                stride[offset + i] = strideC[i];
+        }
+        return stride;
+    }
+
+    const Activation &GemmObj::getActivation() const { return act; }
+
+    void GemmObj::setActivation(const Activation &act_)
+    {
+        act = act_;
+        resetOpDesc();
+    }
+
+    size_t GemmObj::getWorkspaceSize(const RuntimeObj *runtime)
+    {
+        return static_cast<Desc *>(getInfiniOpDesc(runtime))->workspaceSize;
+    }
+
 } // namespace infini
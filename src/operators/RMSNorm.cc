@@ -9,6 +9,9 @@ namespace infini
         IT_ASSERT(checkValid(graph));
     }
 
+    RMSNormObj::RMSNormObj(Unchecked, Tensor X, Tensor Y, Tensor W, float epsilon)
+        : OperatorObj(OpType::RMSNorm, TensorVec{X, W}, {Y}), epsilon(epsilon) {}
+
     string RMSNormObj::toString() const
     {
         std::ostringstream os;
@@ -20,6 +23,18 @@ namespace infini
         return os.str();
     }
 
+    Operator RMSNormObj::clone(const TensorVec &inputs_, const TensorVec &outputs_) const
+    {
+        return make_ref<RMSNormObj>(Unchecked{}, inputs_[0], outputs_[0], inputs_[1],
+                                    epsilon);
+    }
+
+    bool RMSNormObj::addAttrs(DescriptorKey &key) const
+    {
+        key.add(epsilon);
+        return true;
+    }
+
     optional<vector<Shape>> RMSNormObj::inferShape() 
     {
         const auto X = inputs[0];
@@ -32,7 +47,7 @@ namespace infini
         return {inputs[0]->getDataType()};
     }
 
-    void RMSNormObj::createOpDesc()
+    Ref<void> RMSNormObj::createOpDesc(infiniopHandle_t handle)
     {
         auto xShape = inputs[0]->getShape();
         auto wShape = inputs[1]->getShape();
@@ -50,16 +65,40 @@ namespace infini
         CHECK_INFINI_ERROR(infiniopCreateTensorDescriptor(
             &wTensor, wShape.size(), wShape.data(), wStride.data(),
             inputs[1]->getDataType().getType()));
-        infiniopHandle_t handle = nullptr;
-        CHECK_INFINI_ERROR(infiniopCreateHandle(&handle));
         // create RMSNorm op descriptor
+        infiniopRMSNormDescriptor_t desc = nullptr;
         CHECK_INFINI_ERROR(infiniopCreateRMSNormDescriptor(
-            handle, (infiniopRMSNormDescriptor_t *)&infiniOpDesc, yTensor, xTensor,
+            handle, &desc, yTensor, xTensor,
             wTensor, epsilon));
 
         CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(yTensor));
         CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(xTensor));
         CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(wTensor));
+        return Ref<void>(desc, [](void *ptr)
+                         {
+            auto err = infiniopDestroyRMSNormDescriptor((infiniopRMSNormDescriptor_t)ptr);
+            if (err != INFINI_STATUS_SUCCESS)
+            {
+                std::cerr << "Warning: RMSNorm descriptor destroy failed with error code "
+                          << err << std::endl;
+            } });
+    }
+
+    void RMSNormObj::addDescAttrs(DescriptorKey &key) const { key.add(epsilon); }
+
+    float RMSNormObj::getEpsilon() const { return epsilon; }
+
+    vector<pair<int, int>> RMSNormObj::getInplacePairs() const
+    {
+        return {{0, 0}};
+    }
+
+    size_t RMSNormObj::getWorkspaceSize(const RuntimeObj *runtime)
+    {
+        size_t size = 0;
+        CHECK_INFINI_ERROR(infiniopGetRMSNormWorkspaceSize(
+            (infiniopRMSNormDescriptor_t)getInfiniOpDesc(runtime), &size));
+        return size;
     }
 
 } // namespace infini
@@ -0,0 +1,103 @@
+#include "operators/Transpose.h"
+#include "core/runtime.h"
+
+namespace infini
+{
+    TransposeObj::TransposeObj(GraphObj *graph, Tensor X, Tensor Y, vector<int> perm)
+        : OperatorObj(OpType::Transpose, {X}, {Y}), perm(std::move(perm))
+    {
+        IT_ASSERT(checkValid(graph));
+    }
+
+    TransposeObj::TransposeObj(Unchecked, Tensor X, Tensor Y, vector<int> perm)
+        : OperatorObj(OpType::Transpose, {X}, {Y}), perm(std::move(perm)) {}
+
+    string TransposeObj::toString() const
+    {
+        std::ostringstream os;
+        os << "Transpose( X=" << inputs[0]->getGuid() << ",Y=" << outputs[0]->getGuid()
+           << ",perm=" << vecToString(perm) << " )";
+        return os.str();
+    }
+
+    Operator TransposeObj::clone(const TensorVec &inputs_, const TensorVec &outputs_) const
+    {
+        return make_ref<TransposeObj>(Unchecked{}, inputs_[0], outputs_[0], perm);
+    }
+
+    bool TransposeObj::addAttrs(DescriptorKey &key) const
+    {
+        addDescAttrs(key);
+        return true;
+    }
+
+    optional<vector<Shape>> TransposeObj::inferShape()
+    {
+        auto shapeX = inputs[0]->getShape();
+        if (perm.size() != shapeX.size())
+            return std::nullopt;
+        Shape ret(perm.size());
+        vector<bool> seen(perm.size(), false);
+        for (size_t i = 0; i < perm.size(); ++i)
+        {
+            if (perm[i] < 0 || size_t(perm[i]) >= perm.size() || seen[perm[i]])
+                return std::nullopt;
+            seen[perm[i]] = true;
+            ret[i] = shapeX[perm[i]];
+        }
+        return {{ret}};
+    }
+
+    vector<DataType> TransposeObj::inferDataType() const { return {inputs[0]->getDataType()}; }
+
+    Ref<void> TransposeObj::createOpDesc(infiniopHandle_t handle)
+    {
+        // Read X through permuted strides and write Y densely
+        auto yShape = outputs[0]->getShape();
+        auto yStride = outputs[0]->getStride();
+        auto xStride = inputs[0]->getStride();
+        Stride srcStride(perm.size());
+        for (size_t i = 0; i < perm.size(); ++i)
+            srcStride[i] = xStride[perm[i]];
+        auto dtype = outputs[0]->getDataType().getType();
+        infiniopTensorDescriptor_t yTensor, xTensor;
+        CHECK_INFINI_ERROR(infiniopCreateTensorDescriptor(
+            &yTensor, yShape.size(), yShape.data(), yStride.data(), dtype));
+        CHECK_INFINI_ERROR(infiniopCreateTensorDescriptor(
+            &xTensor, yShape.size(), yShape.data(), srcStride.data(), dtype));
+        infiniopRearrangeDescriptor_t desc = nullptr;
+        CHECK_INFINI_ERROR(infiniopCreateRearrangeDescriptor(handle, &desc, yTensor, xTensor));
+        CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(yTensor));
+        CHECK_INFINI_ERROR(infiniopDestroyTensorDescriptor(xTensor));
+        return Ref<void>(desc, [](void *ptr)
+                         {
+            auto err = infiniopDestroyRearrangeDescriptor((infiniopRearrangeDescriptor_t)ptr);
+            if (err != INFINI_STATUS_SUCCESS)
+            {
+                std::cerr << "Warning: Transpose descriptor destroy failed with error code "
+                          << err << std::endl;
+            } });
+    }
+
+    void TransposeObj::addDescAttrs(DescriptorKey &key) const
+    {
+        for (int dim : perm)
+            key.add(dim);
+    }
+
+    const vector<int> &TransposeObj::getPerm() const { return perm; }
+
+    bool TransposeObj::swapsLastTwoDims() const
+    {
+        size_t rank = perm.size();
+        if (rank < 2)
+            return false;
+        for (size_t i = 0; i + 2 < rank; ++i)
+        {
+            if (perm[i] != int(i))
+                return false;
+        }
+        return perm[rank - 2] == int(rank - 1) && perm[rank - 1] == int(rank - 2);
+    }
+
+} // namespace infini
@@ -0,0 +1,87 @@
+#include "utils/histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace infini
+{
+    Histogram::Histogram(vector<double> bounds_)
+        : bounds(std::move(bounds_)), counts(bounds.size() + 1, 0)
+    {
+        IT_ASSERT(std::is_sorted(bounds.begin(), bounds.end()));
+    }
+
+    Histogram Histogram::exponential(double limit)
+    {
+        vector<double> bounds;
+        for (double bound = 1; bound <= limit; bound *= 2)
+            bounds.push_back(bound);
+        return Histogram(std::move(bounds));
+    }
+
+    Histogram Histogram::linear(size_t limit)
+    {
+        vector<double> bounds;
+        for (size_t bound = 1; bound <= limit + 1; ++bound)
+            bounds.push_back(bound);
+        return Histogram(std::move(bounds));
+    }
+
+    void Histogram::add(double value)
+    {
+        auto it = std::upper_bound(bounds.begin(), bounds.end(), value);
+        ++counts[it - bounds.begin()];
+        ++total;
+        sum += value;
+        maxValue = total == 1 ? value : std::max(maxValue, value);
+    }
+
+    void Histogram::clear()
+    {
+        std::fill(counts.begin(), counts.end(), 0);
+        total = 0;
+        sum = 0;
+        maxValue = 0;
+    }
+
+    const vector<double> &Histogram::getBounds() const { return bounds; }
+
+    const vector<size_t> &Histogram::getCounts() const { return counts; }
+
+    size_t Histogram::getTotal() const { return total; }
+
+    double Histogram::getMean() const { return total ? sum / total : 0; }
+
+    double Histogram::getMax() const { return maxValue; }
+
+    double Histogram::getQuantile(double q) const
+    {
+        size_t target = std::ceil(q * total), seen = 0;
+        for (size_t i = 0; i < bounds.size(); ++i)
+        {
+            seen += counts[i];
+            if (seen >= target && seen > 0)
+                return bounds[i];
+        }
+        return maxValue;
+    }
+
+    string Histogram::toString() const
+    {
+        std::ostringstream oss;
+        oss << "n=" << total << " mean=" << getMean() << " max=" << maxValue;
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            if (counts[i] == 0)
+                continue;
+            oss << " [";
+            if (i > 0)
+                oss << bounds[i - 1];
+            oss << ",";
+            if (i < bounds.size())
+                oss << bounds[i];
+            oss << "):" << counts[i];
+        }
+        return oss.str();
+    }
+
+} // namespace infini
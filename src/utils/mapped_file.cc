@@ -0,0 +1,36 @@
+#include "utils/mapped_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace infini
+{
+    MappedFile::MappedFile(const string &path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        IT_ASSERT(fd >= 0, "Cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            IT_ASSERT(false, "Cannot stat " + path);
+        }
+        length = st.st_size;
+        if (length > 0)
+        {
+            addr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        IT_ASSERT(addr != MAP_FAILED, "Cannot mmap " + path);
+        if (length > 0)
+            ::madvise(addr, length, MADV_WILLNEED);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (addr && addr != MAP_FAILED)
+            ::munmap(addr, length);
+    }
+
+} // namespace infini
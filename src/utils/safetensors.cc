@@ -0,0 +1,247 @@
+#include "utils/safetensors.h"
+#include "core/runtime.h"
+#include "utils/mapped_file.h"
+#include <cctype>
+
+namespace infini
+{
+    namespace
+    {
+        // Minimal JSON reader covering what safetensors headers contain
+        class HeaderParser
+        {
+            const char *cur;
+            const char *end;
+
+        public:
+            HeaderParser(const char *data, size_t size) : cur(data), end(data + size) {}
+
+            void skipSpace()
+            {
+                while (cur < end && std::isspace(static_cast<unsigned char>(*cur)))
+                    ++cur;
+            }
+
+            bool consume(char c)
+            {
+                skipSpace();
+                if (cur < end && *cur == c)
+                {
+                    ++cur;
+                    return true;
+                }
+                return false;
+            }
+
+            void expect(char c)
+            {
+                IT_ASSERT(consume(c), string("Malformed safetensors header: expected '") +
+                                          c + "'");
+            }
+
+            string parseString()
+            {
+                expect('"');
+                string str;
+                while (cur < end && *cur != '"')
+                {
+                    if (*cur == '\\')
+                    {
+                        ++cur;
+                        IT_ASSERT(cur < end, "Malformed safetensors header");
+                    }
+                    str += *cur++;
+                }
+                expect('"');
+                return str;
+            }
+
+            size_t parseUInt()
+            {
+                skipSpace();
+                IT_ASSERT(cur < end && std::isdigit(static_cast<unsigned char>(*cur)),
+                          "Malformed safetensors header: expected integer");
+                size_t value = 0;
+                while (cur < end && std::isdigit(static_cast<unsigned char>(*cur)))
+                    value = value * 10 + (*cur++ - '0');
+                return value;
+            }
+
+            vector<size_t> parseUIntArray()
+            {
+                vector<size_t> values;
+                expect('[');
+                if (consume(']'))
+                    return values;
+                do
+                {
+                    values.push_back(parseUInt());
+                } while (consume(','));
+                expect(']');
+                return values;
+            }
+
+            // Skip any JSON value (used for __metadata__)
+            void skipValue()
+            {
+                skipSpace();
+                IT_ASSERT(cur < end, "Malformed safetensors header");
+                if (*cur == '"')
+                {
+                    parseString();
+                }
+                else if (*cur == '{' || *cur == '[')
+                {
+                    char close = *cur == '{' ? '}' : ']';
+                    ++cur;
+                    if (consume(close))
+                        return;
+                    do
+                    {
+                        if (close == '}')
+                        {
+                            parseString();
+                            expect(':');
+                        }
+                        skipValue();
+                    } while (consume(','));
+                    expect(close);
+                }
+                else
+                {
+                    while (cur < end && *cur != ',' && *cur != '}' && *cur != ']')
+                        ++cur;
+                }
+            }
+        };
+
+        infiniDtype_t parseDType(const string &name)
+        {
+            static const std::unordered_map<string, infiniDtype_t> dtypes = {
+                {"BOOL", INFINI_DTYPE_BOOL}, {"U8", INFINI_DTYPE_U8},
+                {"I8", INFINI_DTYPE_I8}, {"U16", INFINI_DTYPE_U16},
+                {"I16", INFINI_DTYPE_I16}, {"U32", INFINI_DTYPE_U32},
+                {"I32", INFINI_DTYPE_I32}, {"U64", INFINI_DTYPE_U64},
+                {"I64", INFINI_DTYPE_I64}, {"F16", INFINI_DTYPE_F16},
+                {"BF16", INFINI_DTYPE_BF16}, {"F32", INFINI_DTYPE_F32},
+                {"F64", INFINI_DTYPE_F64}, {"F8_E4M3", INFINI_DTYPE_F8}};
+            // INFINI_DTYPE_F8 is E4M3; E5M2 data would be silently misread
+            IT_ASSERT(name != "F8_E5M2", "Unsupported safetensors dtype F8_E5M2");
+            auto it = dtypes.find(name);
+            IT_ASSERT(it != dtypes.end(), "Unsupported safetensors dtype " + name);
+            return it->second;
+        }
+    } // namespace
+
+    vector<SafeTensorsLoader::Entry> SafeTensorsLoader::parseHeader(const char *header,
+                                                                    size_t size)
+    {
+        vector<Entry> entries;
+        HeaderParser parser(header, size);
+        parser.expect('{');
+        if (parser.consume('}'))
+            return entries;
+        do
+        {
+            string name = parser.parseString();
+            parser.expect(':');
+            if (name == "__metadata__")
+            {
+                parser.skipValue();
+                continue;
+            }
+            optional<infiniDtype_t> dtype;
+            optional<Shape> shape;
+            vector<size_t> offsets;
+            parser.expect('{');
+            do
+            {
+                string key = parser.parseString();
+                parser.expect(':');
+                if (key == "dtype")
+                    dtype = parseDType(parser.parseString());
+                else if (key == "shape")
+                    shape = parser.parseUIntArray();
+                else if (key == "data_offsets")
+                    offsets = parser.parseUIntArray();
+                else
+                    parser.skipValue();
+            } while (parser.consume(','));
+            parser.expect('}');
+            IT_ASSERT(dtype && shape && offsets.size() == 2,
+                      "Incomplete safetensors entry " + name);
+            entries.push_back({name, DataType(*dtype), *shape, offsets[0], offsets[1]});
+        } while (parser.consume(','));
+        parser.expect('}');
+        return entries;
+    }
+
+    std::map<string, Tensor> SafeTensorsLoader::load(const Graph &graph,
+                                                     const string &path)
+    {
+        auto file = std::make_shared<MappedFile>(path);
+        IT_ASSERT(file->size() >= 8, "Truncated safetensors file " + path);
+        uint64_t headerSize = 0;
+        for (int i = 7; i >= 0; --i) // little endian
+            headerSize = (headerSize << 8) | static_cast<unsigned char>(file->data()[i]);
+        IT_ASSERT(headerSize <= file->size() - 8, "Truncated safetensors file " + path);
+        char *dataBegin = file->data() + 8 + headerSize;
+        size_t dataSize = file->size() - 8 - headerSize;
+
+        auto runtime = graph->getRuntime();
+        bool zeroCopy = runtime->getCurrentThreadContext()->device == INFINI_DEVICE_CPU;
+        // Tensors join the graph only once every entry has loaded, so a bad
+        // file leaves the graph untouched
+        std::map<string, Tensor> weights;
+        for (auto &entry : parseHeader(file->data() + 8, headerSize))
+        {
+            auto tensor = make_ref<TensorObj>(entry.shape, entry.dtype);
+            tensor->setWeight(true);
+            IT_ASSERT(entry.begin <= entry.end && entry.end <= dataSize &&
+                          entry.end - entry.begin == tensor->getTotalBytes(),
+                      "Bad data_offsets for tensor " + entry.name);
+            char *src = dataBegin + entry.begin;
+            if (zeroCopy)
+            {
+                // Every tensor keeps the mapping alive
+                tensor->attachBlob(make_ref<BlobObj>(src, file, MemoryLocation::Host));
+            }
+            else
+            {
+                tensor->dataMalloc(runtime);
+                upload(runtime, tensor, src);
+            }
+            weights.emplace(entry.name, tensor);
+        }
+        if (!zeroCopy)
+            runtime->streamSynchronize(runtime->getCurrentStream());
+        for (auto &[name, tensor] : weights)
+            graph->addTensor(tensor);
+        return weights;
+    }
+
+    void SafeTensorsLoader::upload(const Runtime &runtime, const Tensor &tensor,
+                                   const char *src)
+    {
+        auto stream = runtime->getCurrentStream();
+        auto &pool = runtime->getStagingPool();
+        char *dst = tensor->getRawDataPtr<char *>();
+        size_t bytes = tensor->getTotalBytes();
+        int inflight = 0;
+        for (size_t offset = 0; offset < bytes; offset += kChunkSize)
+        {
+            size_t chunk = std::min(kChunkSize, bytes - offset);
+            void *staging = pool.acquire(chunk);
+            std::memcpy(staging, src + offset, chunk);
+            runtime->memcpyAsync(dst + offset, staging, chunk, INFINIRT_MEMCPY_H2D, stream);
+            pool.release(staging, stream);
+            // Bound the pinned memory held by copies still in flight
+            if (++inflight == kMaxInflightChunks)
+            {
+                runtime->streamSynchronize(stream);
+                inflight = 0;
+            }
+        }
+    }
+
+} // namespace infini
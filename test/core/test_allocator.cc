@@ -0,0 +1,116 @@
+#include "core/runtime.h"
+#include "operators/RMSNorm.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    TEST(CachingAllocator, ReuseHitsCache)
+    {
+        RuntimeObj::init();
+        CachingAllocator allocator;
+        void *a = allocator.alloc(1000);
+        int bin = CachingAllocator::getBin(CachingAllocator::roundSize(1000));
+        EXPECT_EQ(allocator.getStats()[bin].misses, 1u);
+        allocator.free(a);
+        void *b = allocator.alloc(1000);
+        EXPECT_EQ(a, b);
+        EXPECT_EQ(allocator.getStats()[bin].hits, 1u);
+        allocator.free(b);
+        EXPECT_EQ(allocator.getAllocatedBytes(), 0u);
+        EXPECT_EQ(allocator.getReservedBytes(), CachingAllocator::kSmallBuffer);
+        allocator.emptyCache();
+        EXPECT_EQ(allocator.getReservedBytes(), 0u);
+    }
+
+    TEST(CachingAllocator, SplitAndMerge)
+    {
+        RuntimeObj::init();
+        CachingAllocator allocator;
+        size_t size = 4 << 20;
+        // Both medium requests are carved out of one 20MiB segment
+        void *a = allocator.alloc(size);
+        void *b = allocator.alloc(size);
+        EXPECT_EQ(static_cast<char *>(b) - static_cast<char *>(a), (ptrdiff_t)size);
+        EXPECT_EQ(allocator.getReservedBytes(), CachingAllocator::kLargeBuffer);
+
+        // A segment is only released when all of its blocks merged back
+        allocator.free(a);
+        allocator.emptyCache();
+        EXPECT_EQ(allocator.getReservedBytes(), CachingAllocator::kLargeBuffer);
+        allocator.free(b);
+        void *c = allocator.alloc(3 * size);
+        EXPECT_EQ(c, a);
+        allocator.free(c);
+        allocator.emptyCache();
+        EXPECT_EQ(allocator.getReservedBytes(), 0u);
+    }
+
+    TEST(CachingAllocator, StreamsDoNotShareBlocks)
+    {
+        RuntimeObj::init();
+        CachingAllocator allocator;
+        infinirtStream_t s1 = nullptr, s2 = nullptr;
+        CHECK_INFINI_ERROR(infinirtStreamCreate(&s1));
+        CHECK_INFINI_ERROR(infinirtStreamCreate(&s2));
+        void *a = allocator.alloc(4096, s1);
+        allocator.free(a);
+        void *b = allocator.alloc(4096, s2);
+        EXPECT_NE(a, b);
+        void *c = allocator.alloc(4096, s1);
+        EXPECT_EQ(a, c);
+        allocator.free(b);
+        allocator.free(c);
+        allocator.emptyCache();
+        EXPECT_EQ(allocator.getReservedBytes(), 0u);
+        CHECK_INFINI_ERROR(infinirtStreamDestroy(s1));
+        CHECK_INFINI_ERROR(infinirtStreamDestroy(s2));
+    }
+
+    TEST(CachingAllocator, RuntimeUsesCache)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        void *a = runtime->allocDevice(12345);
+        runtime->deallocDevice(a);
+        void *b = runtime->allocDevice(12345);
+        EXPECT_EQ(a, b);
+        runtime->deallocDevice(b);
+    }
+
+    TEST(CachingAllocator, CrossStreamFreeIsDeferred)
+    {
+        RuntimeObj::init();
+        CachingAllocator allocator;
+        infinirtStream_t stream = nullptr;
+        CHECK_INFINI_ERROR(infinirtStreamCreate(&stream));
+        void *a = allocator.alloc(4096);
+        allocator.free(a, stream);
+        EXPECT_EQ(allocator.getPendingBlocks(), 1u);
+        EXPECT_EQ(allocator.getAllocatedBytes(), 0u);
+        // Reclaimed once the event recorded on `stream` has completed
+        allocator.emptyCache();
+        EXPECT_EQ(allocator.getPendingBlocks(), 0u);
+        EXPECT_EQ(allocator.getReservedBytes(), 0u);
+        CHECK_INFINI_ERROR(infinirtStreamDestroy(stream));
+    }
+
+    TEST(CachingAllocator, DroppedGraphReleasesMemory)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        size_t before = runtime->getAllocator().getAllocatedBytes();
+        {
+            Graph g = make_ref<GraphObj>(runtime);
+            DataType dtype(INFINI_DTYPE_F32);
+            auto W = g->addTensor({256}, dtype);
+            Tensor x = g->addTensor({64, 256}, dtype);
+            for (int i = 0; i < 4; ++i)
+                x = g->addOp<RMSNormObj>(x, nullptr, W)->getOutput(0);
+            g->dataMalloc();
+            EXPECT_GT(runtime->getAllocator().getAllocatedBytes(), before);
+        }
+        runtime->emptyCache();
+        EXPECT_EQ(runtime->getAllocator().getAllocatedBytes(), before);
+    }
+} // namespace infini
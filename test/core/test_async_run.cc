@@ -0,0 +1,108 @@
+#include "core/runtime.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    TEST(AsyncRun, PipelinedRunsMatchSyncRuns)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({4, 8}, dtype);
+        auto B = g->addTensor({8, 8}, dtype);
+        auto C = g->addTensor({8, 4}, dtype);
+        auto H = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        auto Y = g->addOp<GemmObj>(H, C, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        g->dataMalloc();
+        ASSERT_TRUE(g->getMemoryPlan().isPlanned(H));
+        vector<float> b(B->getElement()), c(C->getElement());
+        std::iota(b.begin(), b.end(), -8.0f);
+        std::iota(c.begin(), c.end(), 1.0f);
+        B->copyFromHost(runtime, b.data());
+        C->copyFromHost(runtime, c.data());
+
+        const int numRuns = 5;
+        vector<vector<float>> inputs, expected;
+        for (int r = 0; r < numRuns; ++r)
+        {
+            vector<float> a(A->getElement()), y(Y->getElement());
+            std::iota(a.begin(), a.end(), float(r));
+            A->copyFromHost(runtime, a.data());
+            runtime->run(g);
+            Y->copyToHost(runtime, y.data());
+            inputs.push_back(a);
+            expected.push_back(y);
+        }
+
+        runtime->setMaxInFlightRuns(3);
+        vector<RunFuture> futures;
+        for (int r = 0; r < numRuns; ++r)
+            futures.push_back(runtime->runAsync(g, {{A, inputs[r].data()}}));
+        auto pool = g->getAsyncPool();
+        ASSERT_NE(pool, nullptr);
+        EXPECT_EQ(pool->getNumSlots(), 3u);
+        EXPECT_NE(pool->getBuffer(0, H), pool->getBuffer(1, H));
+        EXPECT_NE(pool->getBuffer(1, Y), pool->getBuffer(2, Y));
+        EXPECT_EQ(pool->getBuffer(0, A), A->getRawDataPtr<void *>());
+
+        // Outputs stay valid after the slot was reused by later runs
+        for (int r = numRuns - 1; r >= 0; --r)
+        {
+            vector<float> y(Y->getElement());
+            futures[r].getOutput(Y, y.data());
+            EXPECT_TRUE(futures[r].ready());
+            EXPECT_EQ(y, expected[r]) << "run " << r;
+        }
+
+        // The pool is rebuilt when the bound changes
+        runtime->setMaxInFlightRuns(2);
+        runtime->runAsync(g, {{A, inputs[0].data()}}).wait();
+        EXPECT_EQ(g->getAsyncPool()->getNumSlots(), 2u);
+        runtime->setMaxInFlightRuns(2);
+    }
+
+    TEST(AsyncRun, DeclaredOutputsWithReaders)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({4, 4}, dtype);
+        auto B = g->addTensor({4, 4}, dtype);
+        auto H = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        auto T = g->addOp<GemmObj>(H, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        auto U = g->addOp<GemmObj>(T, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        auto Y = g->addOp<GemmObj>(U, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        // H is read by a later op but is still an output of the graph
+        g->setOutputs({H, Y});
+        g->dataMalloc();
+        EXPECT_FALSE(g->getMemoryPlan().isPlanned(H));
+        vector<float> a(16), b(16);
+        std::iota(a.begin(), a.end(), 0.0f);
+        std::iota(b.begin(), b.end(), -8.0f);
+        B->copyFromHost(runtime, b.data());
+        A->copyFromHost(runtime, a.data());
+        runtime->run(g);
+        vector<float> h(16), y(16);
+        H->copyToHost(runtime, h.data());
+        Y->copyToHost(runtime, y.data());
+
+        runtime->setMaxInFlightRuns(2);
+        vector<RunFuture> futures;
+        for (int r = 0; r < 3; ++r)
+            futures.push_back(runtime->runAsync(g, {{A, a.data()}}));
+        for (auto &future : futures)
+        {
+            vector<float> outH(16), outY(16);
+            future.getOutput(H, outH.data());
+            future.getOutput(Y, outY.data());
+            EXPECT_EQ(outH, h);
+            EXPECT_EQ(outY, y);
+        }
+    }
+
+} // namespace infini
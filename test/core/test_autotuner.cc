@@ -0,0 +1,127 @@
+#include "core/runtime.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+#include "test_ops.h"
+#include <cstdio>
+
+REGISTER_KERNEL_VARIANT(INFINI_DEVICE_CPU, OpType::Unknown, SlowKernel, "SlowKernel", 1);
+REGISTER_KERNEL_VARIANT(INFINI_DEVICE_CPU, OpType::Unknown, FastKernel, "FastKernel", 0);
+REGISTER_KERNEL_VARIANT(INFINI_DEVICE_CPU, OpType::Unknown, VectorKernel, "VectorKernel", 2);
+
+namespace infini
+{
+    static const Kernel *findKernel(OpType type, const string &name)
+    {
+        for (auto &item : KernelRegistry::getInstance().getKernelItems(
+                 KernelAttrs{INFINI_DEVICE_CPU, type.underlying()}))
+        {
+            if (std::get<1>(item) == name)
+                return std::get<0>(item);
+        }
+        return nullptr;
+    }
+
+    TEST(Autotuner, PicksFastestAndPersists)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        string path = ::testing::TempDir() + "tuning_cache.txt";
+        std::remove(path.c_str());
+
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({4, 4}, DataType(INFINI_DTYPE_F32));
+        auto op = g->addOp<UnknownObj>(X, nullptr);
+        g->dataMalloc();
+
+        {
+            Autotuner tuner;
+            tuner.setCachePath(path);
+            tuner.setEnabled(false);
+            // Rank decides without tuning; VectorKernel does not apply
+            EXPECT_EQ(tuner.select(op, runtime.get()), findKernel(OpType::Unknown, "SlowKernel"));
+            tuner.setEnabled(true);
+            EXPECT_EQ(tuner.select(op, runtime.get()), findKernel(OpType::Unknown, "FastKernel"));
+            EXPECT_EQ(tuner.getNumTuned(), 1u);
+            tuner.select(op, runtime.get());
+            EXPECT_EQ(tuner.getNumTuned(), 1u);
+        }
+
+        // A later process reloads the winner without timing again
+        Autotuner reloaded;
+        reloaded.setCachePath(path);
+        EXPECT_EQ(reloaded.size(), 1u);
+        EXPECT_EQ(reloaded.select(op, runtime.get()), findKernel(OpType::Unknown, "FastKernel"));
+        EXPECT_EQ(reloaded.getNumTuned(), 0u);
+        std::remove(path.c_str());
+    }
+
+    TEST(Autotuner, ChoiceIsKeptOnOp)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({4, 4}, DataType(INFINI_DTYPE_F32));
+        auto op = g->addOp<UnknownObj>(X, nullptr);
+        g->dataMalloc();
+
+        Autotuner tuner;
+        auto kernel = tuner.select(op, runtime.get());
+        size_t checks = applicableChecks;
+        for (int i = 0; i < 3; ++i)
+            EXPECT_EQ(tuner.select(op, runtime.get()), kernel);
+        // No candidate filtering or signature after the first lookup
+        EXPECT_EQ(applicableChecks, checks);
+        EXPECT_EQ(tuner.getNumSelects(), 4u);
+
+        // New shapes choose again, VectorKernel becomes a candidate
+        X->setShape({16});
+        g->shape_infer();
+        tuner.select(op, runtime.get());
+        EXPECT_GT(applicableChecks, checks);
+
+        // So does a change of the tuner's settings
+        checks = applicableChecks;
+        tuner.setEnabled(false);
+        tuner.select(op, runtime.get());
+        EXPECT_GT(applicableChecks, checks);
+    }
+
+    TEST(Autotuner, GemmVariantsAgree)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({2, 5, 7}, dtype);
+        auto B = g->addTensor({7, 3}, dtype);
+        auto op = g->addOp<GemmObj>(A, B, nullptr, nullptr, 0.5f, 0.0f);
+        auto Y = op->getOutput(0);
+        g->dataMalloc();
+        vector<float> a(A->getElement()), b(B->getElement());
+        for (size_t i = 0; i < a.size(); ++i)
+            a[i] = float(i % 11) - 5.0f;
+        for (size_t i = 0; i < b.size(); ++i)
+            b[i] = float(i % 7) * 0.5f;
+        A->copyFromHost(runtime, a.data());
+        B->copyFromHost(runtime, b.data());
+
+        auto native = findKernel(OpType::Gemm, "GemmCpu");
+        ASSERT_NE(native, nullptr);
+        EXPECT_TRUE(native->isApplicable(op));
+        vector<float> expected(Y->getElement()), result(Y->getElement());
+        runtime->getWorkspace(op->getWorkspaceSize(runtime.get()));
+        for (auto &item : KernelRegistry::getInstance().getKernelItems(
+                 KernelAttrs{INFINI_DEVICE_CPU, OpType::Gemm}))
+        {
+            std::get<0>(item)->compute(op, runtime.get());
+            Y->copyToHost(runtime, std::get<0>(item) == native ? result.data()
+                                                                : expected.data());
+        }
+        for (size_t i = 0; i < result.size(); ++i)
+            EXPECT_FLOAT_EQ(result[i], expected[i]);
+    }
+
+} // namespace infini
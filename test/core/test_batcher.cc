@@ -0,0 +1,88 @@
+#include "core/batcher.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    TEST(DynamicBatcher, CoalescesRequests)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        const size_t k = 8, n = 4;
+        auto A = g->addTensor({1, k}, dtype);
+        auto W = g->addTensor({k, n}, dtype);
+        auto Y = g->addOp<GemmObj>(A, W, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        vector<float> w(k * n);
+        std::iota(w.begin(), w.end(), -4.0f);
+        W->dataMalloc(runtime);
+        W->copyFromHost(runtime, w.data());
+
+        DynamicBatcher::Config config;
+        config.maxBatchSize = 4;
+        config.maxWait = std::chrono::milliseconds(200);
+        DynamicBatcher batcher(runtime, g, {A}, {Y}, config);
+
+        const int numRequests = 10;
+        vector<vector<float>> rows;
+        vector<std::future<DynamicBatcher::Result>> futures;
+        for (int r = 0; r < numRequests; ++r)
+        {
+            vector<float> a(k);
+            std::iota(a.begin(), a.end(), float(r));
+            rows.push_back(a);
+            futures.push_back(batcher.submit({rows.back().data()}));
+        }
+        for (int r = 0; r < numRequests; ++r)
+        {
+            auto result = futures[r].get();
+            ASSERT_EQ(result.at(Y).size(), n * sizeof(float));
+            vector<float> y(n), expected(n, 0.0f);
+            std::memcpy(y.data(), result.at(Y).data(), result.at(Y).size());
+            for (size_t j = 0; j < n; ++j)
+                for (size_t p = 0; p < k; ++p)
+                    expected[j] += rows[r][p] * w[p * n + j];
+            EXPECT_EQ(y, expected) << "request " << r;
+        }
+
+        auto stats = batcher.getStats();
+        EXPECT_EQ(stats.requests, size_t(numRequests));
+        EXPECT_EQ(stats.batchSize.getTotal(), stats.batches);
+        EXPECT_LE(stats.batchSize.getMax(), 4);
+        EXPECT_LT(stats.batches, size_t(numRequests));
+        EXPECT_EQ(stats.queueDelayUs.getTotal(), size_t(numRequests));
+    }
+
+    TEST(DynamicBatcher, FlushesAfterMaxWait)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({1, 4}, dtype);
+        auto W = g->addTensor({4, 4}, dtype);
+        auto Y = g->addOp<GemmObj>(A, W, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        W->dataMalloc(runtime);
+        vector<float> w(16, 1.0f), a(4, 1.0f);
+        W->copyFromHost(runtime, w.data());
+
+        DynamicBatcher::Config config;
+        config.maxBatchSize = 64;
+        config.maxWait = std::chrono::milliseconds(20);
+        DynamicBatcher batcher(runtime, g, {A}, {Y}, config);
+        auto future = batcher.submit({a.data()});
+        // A lone request is not held back waiting for a full batch
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        auto result = future.get();
+        vector<float> y(4);
+        std::memcpy(y.data(), result.at(Y).data(), sizeof(float) * 4);
+        EXPECT_EQ(y, vector<float>(4, 4.0f));
+        auto stats = batcher.getStats();
+        EXPECT_EQ(stats.batches, 1u);
+        EXPECT_GE(stats.queueDelayUs.getMax(), 20000 * 0.9);
+    }
+
+} // namespace infini
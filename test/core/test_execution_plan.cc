@@ -0,0 +1,154 @@
+#include "core/runtime.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+#include "test_ops.h"
+
+REGISTER_KERNEL(INFINI_DEVICE_CPU, OpType::Unknown, NopKernel, "NopKernel_CPU");
+
+namespace infini
+{
+    static Graph buildNopChain(const Runtime &runtime, size_t numOps)
+    {
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({1}, DataType(INFINI_DTYPE_F32));
+        for (size_t i = 0; i < numOps; ++i)
+            x = g->addOp<UnknownObj>(x, nullptr)->getOutput(0);
+        g->dataMalloc();
+        return g;
+    }
+
+    TEST(ExecutionPlan, PreparedRunsSkipLookups)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        const size_t numOps = 100;
+        const int iterations = 10;
+        auto g = buildNopChain(runtime, numOps);
+        auto &tuner = runtime->getAutotuner();
+        auto &descriptors = runtime->getDescriptorCache();
+
+        size_t selects = tuner.getNumSelects();
+        runtime->run(g);
+        // Without a plan every op looks up its kernel on each run
+        EXPECT_EQ(tuner.getNumSelects(), selects + numOps);
+
+        runtime->prepare(g);
+        ASSERT_NE(g->getPlan(), nullptr);
+        selects = tuner.getNumSelects();
+        size_t hits = descriptors.getHits(), misses = descriptors.getMisses();
+        nopLaunches = 0;
+        for (int i = 0; i < iterations; ++i)
+            runtime->run(g);
+        EXPECT_EQ(nopLaunches, numOps * iterations);
+        EXPECT_EQ(tuner.getNumSelects(), selects);
+        EXPECT_EQ(descriptors.getHits(), hits);
+        EXPECT_EQ(descriptors.getMisses(), misses);
+    }
+
+    // Host cost per op of trivial kernels with and without a plan. Timing is
+    // machine dependent, so the numbers are only reported as test properties
+    // (see --gtest_output=xml), never asserted.
+    TEST(ExecutionPlan, DispatchOverhead)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        const size_t numOps = 100;
+        const int iterations = 100;
+        auto g = buildNopChain(runtime, numOps);
+        auto nsPerOp = [&]
+        {
+            runtime->run(g); // warm up caches
+            auto begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i)
+                runtime->run(g);
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count();
+            return ns / static_cast<int64_t>(numOps * iterations);
+        };
+
+        nopLaunches = 0;
+        int64_t unprepared = nsPerOp();
+        runtime->prepare(g);
+        int64_t prepared = nsPerOp();
+        EXPECT_EQ(nopLaunches, 2 * numOps * (iterations + 1));
+        RecordProperty("unprepared_ns_per_op", std::to_string(unprepared));
+        RecordProperty("prepared_ns_per_op", std::to_string(prepared));
+    }
+
+    TEST(ExecutionPlan, MatchesUnpreparedRun)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({4, 8}, dtype);
+        auto B = g->addTensor({8, 8}, dtype);
+        auto Y = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        g->dataMalloc();
+        vector<float> a(A->getElement()), b(B->getElement());
+        std::iota(a.begin(), a.end(), 0.0f);
+        std::iota(b.begin(), b.end(), 1.0f);
+        A->copyFromHost(runtime, a.data());
+        B->copyFromHost(runtime, b.data());
+
+        vector<float> expected(Y->getElement()), result(Y->getElement());
+        runtime->run(g);
+        Y->copyToHost(runtime, expected.data());
+        Y->copyFromHost(runtime, result.data()); // clear the output
+        runtime->prepare(g);
+        runtime->run(g);
+        Y->copyToHost(runtime, result.data());
+        EXPECT_EQ(result, expected);
+
+        // Shape changes drop the plan
+        g->shape_infer();
+        EXPECT_EQ(g->getPlan(), nullptr);
+    }
+
+    TEST(ExecutionPlan, RebindAfterPrepare)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({2, 3}, dtype);
+        auto B = g->addTensor({3, 2}, dtype);
+        auto Y = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        vector<float> b{1, 0, 0, 1, 1, 1};
+        auto a = std::make_unique<vector<float>>(vector<float>{1, 2, 3, 4, 5, 6});
+        A->bindExternal(a->data(), MemoryLocation::Host);
+        B->bindExternal(b.data(), MemoryLocation::Host);
+        g->dataMalloc();
+        runtime->prepare(g);
+        auto plan = g->getPlan();
+        vector<float> y(4);
+        runtime->run(g);
+        Y->copyToHost(runtime, y.data());
+        EXPECT_EQ(y, (vector<float>{4, 5, 10, 11}));
+
+        // The old buffer is gone; the plan must not launch with it
+        vector<float> a2{0, 1, 0, 1, 0, 1};
+        A->bindExternal(a2.data(), MemoryLocation::Host);
+        a.reset();
+        runtime->run(g);
+        Y->copyToHost(runtime, y.data());
+        EXPECT_EQ(y, (vector<float>{0, 1, 2, 1}));
+
+        // The output moves to a fresh blob that the plan keeps alive
+        auto out = make_ref<TensorObj>(Y->getShape(), dtype);
+        out->dataMalloc(runtime);
+        Y->attachBlob(out->getData());
+        out = nullptr;
+        runtime->run(g);
+        EXPECT_EQ(g->getPlan(), plan);
+        EXPECT_EQ(plan->records[0].blobs[0], Y->getData());
+        Y->copyToHost(runtime, y.data());
+        EXPECT_EQ(y, (vector<float>{0, 1, 2, 1}));
+    }
+
+} // namespace infini
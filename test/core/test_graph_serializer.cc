@@ -0,0 +1,175 @@
+#include "core/graph_serializer.h"
+#include "core/runtime.h"
+#include "operators/Gemm.h"
+#include "operators/RMSNorm.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace infini
+{
+    TEST(GraphSerializer, RoundTrip)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({2, 4}, dtype);
+        auto W = g->addTensor({4, 3}, dtype);
+        auto N = g->addTensor({3}, dtype);
+        auto Y = g->addOp<GemmObj>(X, W, nullptr, nullptr, 0.5f, 0.0f)->getOutput(0);
+        auto Z = g->addOp<RMSNormObj>(Y, nullptr, N, 1e-5f)->getOutput(0);
+        g->dataMalloc();
+        vector<float> xData(8), wData(12), nData{1, 2, 3};
+        std::iota(xData.begin(), xData.end(), 1.0f);
+        std::iota(wData.begin(), wData.end(), -3.0f);
+        X->copyFromHost(runtime, xData.data());
+        W->copyFromHost(runtime, wData.data());
+        N->copyFromHost(runtime, nData.data());
+        runtime->run(g);
+        vector<float> expected(Z->getElement());
+        Z->copyToHost(runtime, expected.data());
+
+        string path = testing::TempDir() + "graph.itg";
+        GraphSerializer::save(g, path);
+        Graph loaded = GraphSerializer::load(runtime, path);
+        std::remove(path.c_str());
+
+        ASSERT_EQ(loaded->getTensors().size(), g->getTensors().size());
+        ASSERT_EQ(loaded->getOperators().size(), 2u);
+        EXPECT_TRUE(loaded->checkValid());
+        auto gemm = as<GemmObj>(loaded->getOperators()[0]);
+        ASSERT_NE(gemm, nullptr);
+        EXPECT_FLOAT_EQ(gemm->getAlpha(), 0.5f);
+        EXPECT_FLOAT_EQ(gemm->getBeta(), 0.0f);
+        auto norm = as<RMSNormObj>(loaded->getOperators()[1]);
+        ASSERT_NE(norm, nullptr);
+        EXPECT_FLOAT_EQ(norm->getEpsilon(), 1e-5f);
+        EXPECT_EQ(norm->getPredecessors().front(), gemm);
+
+        loaded->dataMalloc();
+        runtime->run(loaded);
+        auto out = loaded->getOperators()[1]->getOutput(0);
+        vector<float> actual(out->getElement());
+        out->copyToHost(runtime, actual.data());
+        EXPECT_EQ(actual, expected);
+    }
+
+    TEST(GraphSerializer, StoresViewsContiguously)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto W = make_ref<TensorObj>(Shape{3, 4}, dtype);
+        W->dataMalloc(runtime);
+        vector<float> wData(12);
+        std::iota(wData.begin(), wData.end(), -5.0f);
+        W->copyFromHost(runtime, wData.data());
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({2, 4}, dtype);
+        auto Wt = g->addTensor(W->transpose({1, 0}));
+        auto Y = g->addOp<GemmObj>(X, Wt, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        g->dataMalloc();
+        vector<float> xData(8);
+        std::iota(xData.begin(), xData.end(), 1.0f);
+        X->copyFromHost(runtime, xData.data());
+        runtime->run(g);
+        vector<float> expected(Y->getElement());
+        Y->copyToHost(runtime, expected.data());
+
+        string path = testing::TempDir() + "graph_view.itg";
+        GraphSerializer::save(g, path);
+        Graph loaded = GraphSerializer::load(runtime, path);
+        std::remove(path.c_str());
+        auto B = loaded->getOperators()[0]->getInput(1);
+        EXPECT_TRUE(B->isContiguous());
+        EXPECT_EQ(B->getShape(), (Shape{4, 3}));
+        loaded->dataMalloc();
+        loaded->getOperators()[0]->getInput(0)->copyFromHost(runtime, xData.data());
+        runtime->run(loaded);
+        auto out = loaded->getOperators()[0]->getOutput(0);
+        vector<float> actual(out->getElement());
+        out->copyToHost(runtime, actual.data());
+        EXPECT_EQ(actual, expected);
+    }
+
+    TEST(GraphSerializer, RejectsForeignFile)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        string path = testing::TempDir() + "not_a_graph.itg";
+        std::ofstream(path) << "definitely not a graph file";
+        EXPECT_THROW(GraphSerializer::load(runtime, path), Exception);
+        std::remove(path.c_str());
+    }
+
+    TEST(GraphSerializer, RejectsWrappingDataOffset)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({2, 4}, dtype);
+        auto W = g->addTensor({4, 3}, dtype);
+        g->addOp<GemmObj>(X, W, nullptr, nullptr, 1.0f, 0.0f);
+        g->dataMalloc();
+        string path = testing::TempDir() + "corrupt.itg";
+        GraphSerializer::save(g, path);
+
+        // Data offset of the first tensor record (rank 2), chosen so that
+        // offset + bytes wraps around to a small value
+        size_t recordOffset = 40 + 12 + 2 * 8 + 2 * 8;
+        uint64_t offset = ~uint64_t(0) - 16;
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(recordOffset);
+            file.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+        }
+        EXPECT_THROW(GraphSerializer::load(runtime, path), Exception);
+        std::remove(path.c_str());
+    }
+
+    TEST(GraphSerializer, LoadsVersion1)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({2, 4}, dtype);
+        auto W = g->addTensor({4, 3}, dtype);
+        g->addOp<GemmObj>(X, W, nullptr, nullptr, 0.5f, 0.0f);
+        string path = testing::TempDir() + "graph_v1.itg";
+        GraphSerializer::save(g, path, false);
+
+        // Rewrite as version 1: the Gemm attributes end after transB. The
+        // three tensor records of rank 2 are followed by the op record.
+        string bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), {});
+        }
+        uint32_t version = 1, attrBytes = 4 + 4 + 1 + 1;
+        size_t attrBytesOffset = 40 + 3 * (12 + 2 * 8 + 2 * 8 + 16) + 2 + 4 + 4 + 3 * 4;
+        std::memcpy(&bytes[8], &version, sizeof(version));
+        std::memcpy(&bytes[attrBytesOffset], &attrBytes, sizeof(attrBytes));
+        bytes.erase(attrBytesOffset + 4 + attrBytes, 1 + 4 + 4);
+        bytes.append(1 + 4 + 4, '\0');
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+
+        Graph loaded = GraphSerializer::load(runtime, path);
+        std::remove(path.c_str());
+        ASSERT_EQ(loaded->getOperators().size(), 1u);
+        EXPECT_TRUE(loaded->checkValid());
+        auto gemm = as<GemmObj>(loaded->getOperators()[0]);
+        ASSERT_NE(gemm, nullptr);
+        EXPECT_FLOAT_EQ(gemm->getAlpha(), 0.5f);
+        EXPECT_EQ(gemm->getActivation().type, ActType::None);
+        EXPECT_EQ(gemm->getOutput(0)->getShape(), (Shape{2, 3}));
+    }
+} // namespace infini
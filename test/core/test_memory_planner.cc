@@ -0,0 +1,201 @@
+#include "core/runtime.h"
+#include "operators/RMSNorm.h"
+#include "gtest/gtest.h"
+#include <cmath>
+
+namespace infini
+{
+    TEST(MemoryPlanner, ChainReusesBuffers)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto W = g->addTensor({64}, dtype);
+        Tensor x = g->addTensor({16, 64}, dtype);
+        auto input = x;
+        TensorVec hidden;
+        for (int i = 0; i < 6; ++i)
+        {
+            auto op = g->addOp<RMSNormObj>(x, nullptr, W);
+            x = op->getOutput(0);
+            hidden.push_back(x);
+        }
+        g->dataMalloc();
+
+        const auto &plan = g->getMemoryPlan();
+        size_t bytes = MemoryPlanner::alignSize(input->getTotalBytes());
+        // Five intermediates; RMSNorm runs in place, so they share one buffer
+        EXPECT_EQ(plan.offsets.size(), 5u);
+        EXPECT_EQ(plan.naiveSize, 5 * bytes);
+        EXPECT_EQ(plan.inplaceCount, 4u);
+        EXPECT_EQ(plan.arenaSize, bytes);
+        EXPECT_FALSE(plan.isPlanned(W));
+        EXPECT_FALSE(plan.isPlanned(input));
+        EXPECT_FALSE(plan.isPlanned(hidden.back()));
+        for (size_t i = 0; i + 2 < hidden.size(); ++i)
+        {
+            EXPECT_EQ(hidden[i]->getRawDataPtr<void *>(),
+                      hidden[i + 1]->getRawDataPtr<void *>());
+        }
+    }
+
+    TEST(MemoryPlanner, BranchKeepsLiveTensorsApart)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto W = g->addTensor({8}, dtype);
+        auto X = g->addTensor({4, 8}, dtype);
+        auto a = g->addOp<RMSNormObj>(X, nullptr, W)->getOutput(0);
+        auto b = g->addOp<RMSNormObj>(a, nullptr, W)->getOutput(0);
+        auto c = g->addOp<RMSNormObj>(b, nullptr, W)->getOutput(0);
+        auto d = g->addOp<RMSNormObj>(a, nullptr, W)->getOutput(0);
+        g->addOp<RMSNormObj>(c, nullptr, W);
+        g->addOp<RMSNormObj>(d, nullptr, W);
+        g->dataMalloc();
+
+        // Tensors whose live ranges overlap must not share memory, unless one
+        // is computed in place from the other
+        const auto &ops = g->getOperators();
+        auto index = [&](const Operator &op)
+        { return std::find(ops.begin(), ops.end(), op) - ops.begin(); };
+        auto range = [&](const Tensor &t)
+        {
+            long end = index(t->getSource());
+            for (auto &target : t->getTargets())
+                end = std::max(end, index(target));
+            return std::make_pair(index(t->getSource()), end);
+        };
+        // `out` may overwrite `in` if it is produced by the last reader of `in`
+        auto aliases = [&](const Tensor &in, const Tensor &out)
+        { return range(in).second == index(out->getSource()); };
+        const auto &plan = g->getMemoryPlan();
+        auto disjoint = [&](const Tensor &t1, const Tensor &t2)
+        {
+            size_t off1 = plan.getOffset(t1), off2 = plan.getOffset(t2);
+            return off1 + t1->getTotalBytes() <= off2 || off2 + t2->getTotalBytes() <= off1;
+        };
+        TensorVec planned{a, b, c, d};
+        for (auto &t1 : planned)
+            for (auto &t2 : planned)
+            {
+                if (t1 == t2)
+                    continue;
+                auto [b1, e1] = range(t1);
+                auto [b2, e2] = range(t2);
+                bool inplace = aliases(t1, t2) || aliases(t2, t1);
+                if (b1 <= e2 && b2 <= e1 && !inplace)
+                {
+                    EXPECT_TRUE(disjoint(t1, t2));
+                }
+            }
+        EXPECT_LE(plan.arenaSize, plan.naiveSize);
+        // a is still read after b is produced, so b cannot overwrite it
+        EXPECT_TRUE(disjoint(a, b));
+    }
+
+    TEST(MemoryPlanner, InplaceChainComputesCorrectly)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto W = g->addTensor({4}, dtype);
+        auto X = g->addTensor({2, 4}, dtype);
+        Tensor y = X;
+        for (int i = 0; i < 3; ++i)
+            y = g->addOp<RMSNormObj>(y, nullptr, W)->getOutput(0);
+        g->dataMalloc();
+        EXPECT_EQ(g->getMemoryPlan().inplaceCount, 1u);
+
+        vector<float> xData{1, 2, 3, 4, -1, 0, 1, 2}, wData{1, 1, 1, 1};
+        X->copyFromHost(runtime, xData.data());
+        W->copyFromHost(runtime, wData.data());
+        runtime->run(g);
+        // RMSNorm with unit weight is idempotent up to epsilon
+        vector<float> out(y->getElement());
+        y->copyToHost(runtime, out.data());
+        for (size_t row = 0; row < 2; ++row)
+        {
+            float ss = 0;
+            for (size_t i = 0; i < 4; ++i)
+                ss += xData[row * 4 + i] * xData[row * 4 + i];
+            float rms = std::sqrt(ss / 4);
+            for (size_t i = 0; i < 4; ++i)
+                EXPECT_NEAR(out[row * 4 + i], xData[row * 4 + i] / rms, 1e-4);
+        }
+    }
+
+    TEST(MemoryPlanner, ConcurrentStreamsDoNotShare)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto W = g->addTensor({8}, dtype);
+        auto X = g->addTensor({4, 8}, dtype);
+        // Two branches; serially the second one reuses the first one's buffer
+        auto a = g->addOp<RMSNormObj>(X, nullptr, W)->getOutput(0);
+        auto a2 = g->addOp<RMSNormObj>(a, nullptr, W)->getOutput(0);
+        auto ya = g->addOp<RMSNormObj>(a2, nullptr, W)->getOutput(0);
+        auto b = g->addOp<RMSNormObj>(X, nullptr, W)->getOutput(0);
+        auto b2 = g->addOp<RMSNormObj>(b, nullptr, W)->getOutput(0);
+        auto yb = g->addOp<RMSNormObj>(b2, nullptr, W)->getOutput(0);
+        g->dataMalloc();
+        EXPECT_EQ(g->getMemoryPlan().getOffset(a), g->getMemoryPlan().getOffset(b));
+
+        std::unordered_map<OperatorObj *, int> streams;
+        for (auto &t : {a, a2, ya})
+            streams[t->getSource().get()] = 0;
+        for (auto &t : {b, b2, yb})
+            streams[t->getSource().get()] = 1;
+        g->setStreamAssignment(streams);
+        g->dataMalloc();
+        const auto &plan = g->getMemoryPlan();
+        for (auto &t1 : {a, a2})
+            for (auto &t2 : {b, b2})
+                EXPECT_NE(plan.getOffset(t1), plan.getOffset(t2));
+    }
+
+    TEST(MemoryPlanner, InplaceWaitsForConcurrentReaders)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto W = g->addTensor({8}, dtype);
+        auto X = g->addTensor({4, 8}, dtype);
+        auto h = g->addOp<RMSNormObj>(X, nullptr, W)->getOutput(0);
+        // Two readers of h; the later one may overwrite h in place
+        auto z = g->addOp<RMSNormObj>(h, nullptr, W)->getOutput(0);
+        auto r = g->addOp<RMSNormObj>(h, nullptr, W)->getOutput(0);
+        auto yr = g->addOp<RMSNormObj>(r, nullptr, W)->getOutput(0);
+        auto yz = g->addOp<RMSNormObj>(z, nullptr, W)->getOutput(0);
+        g->dataMalloc();
+        EXPECT_EQ(g->getMemoryPlan().getOffset(r), g->getMemoryPlan().getOffset(h));
+
+        // On one stream the readers are still ordered
+        std::unordered_map<OperatorObj *, int> streams;
+        for (auto &t : {h, z, r, yr, yz})
+            streams[t->getSource().get()] = 0;
+        g->setStreamAssignment(streams);
+        g->dataMalloc();
+        EXPECT_EQ(g->getMemoryPlan().getOffset(r), g->getMemoryPlan().getOffset(h));
+
+        // The other reader runs concurrently on stream 1
+        for (auto &t : {z, yz})
+            streams[t->getSource().get()] = 1;
+        g->setStreamAssignment(streams);
+        g->dataMalloc();
+        const auto &plan = g->getMemoryPlan();
+        EXPECT_NE(plan.getOffset(r), plan.getOffset(h));
+        EXPECT_NE(plan.getOffset(z), plan.getOffset(h));
+    }
+} // namespace infini
@@ -0,0 +1,115 @@
+#include "core/runtime.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    // Four chained Gemms with 64x64 weights; returns the output and, when a
+    // budget is set, the offload statistics of the second run. With
+    // `updateWeights`, every weight is rewritten between runs.
+    static vector<float> runGemmChain(size_t budget, OffloadManager::Stats *stats,
+                                      bool updateWeights = false)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        runtime->setMemoryBudget(budget);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto X = g->addTensor({16, 64}, dtype);
+        auto x = X;
+        TensorVec weights;
+        for (int i = 0; i < 4; ++i)
+        {
+            auto W = g->addTensor({64, 64}, dtype);
+            W->setWeight(true);
+            weights.push_back(W);
+            x = g->addOp<GemmObj>(x, W, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        }
+        g->dataMalloc();
+        runtime->setMemoryBudget(0);
+
+        vector<float> data(X->getElement());
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = float(i % 5) * 0.25f;
+        X->copyFromHost(runtime, data.data());
+        auto writeWeights = [&](size_t seed)
+        {
+            for (size_t w = 0; w < weights.size(); ++w)
+            {
+                vector<float> wData(weights[w]->getElement());
+                for (size_t i = 0; i < wData.size(); ++i)
+                    wData[i] = float((i + w + seed) % 7) * 0.01f;
+                weights[w]->copyFromHost(runtime, wData.data());
+            }
+        };
+        writeWeights(0);
+
+        runtime->run(g);
+        runtime->run(g);
+        if (updateWeights)
+        {
+            if (budget > 0)
+            {
+                // Some weights are resident, so the update lands on the device
+                EXPECT_TRUE(std::any_of(weights.begin(), weights.end(),
+                                        [](const Tensor &w)
+                                        { return w->getData()->getLocation() ==
+                                                 MemoryLocation::Device; }));
+            }
+            writeWeights(3);
+            // Evicts and reloads every weight at least once
+            runtime->run(g);
+            runtime->run(g);
+        }
+        if (stats)
+        {
+            EXPECT_NE(g->getOffloader(), nullptr);
+            *stats = g->getOffloader()->getStats();
+        }
+        vector<float> result(x->getElement());
+        x->copyToHost(runtime, result.data());
+        return result;
+    }
+
+    TEST(Offload, MatchesUnlimitedRun)
+    {
+        auto expected = runGemmChain(0, nullptr);
+
+        // Arena and workspace take less than 16KiB; what is left holds the
+        // input, the output and two of the four weights, so weights have to
+        // cycle through the device
+        size_t weightBytes = 64 * 64 * sizeof(float);
+        size_t budget = 16 * 1024 + 2 * 16 * 64 * sizeof(float) + 2 * weightBytes;
+        OffloadManager::Stats stats;
+        auto result = runGemmChain(budget, &stats);
+
+        ASSERT_EQ(result.size(), expected.size());
+        for (size_t i = 0; i < result.size(); ++i)
+            EXPECT_FLOAT_EQ(result[i], expected[i]);
+        EXPECT_GT(stats.evictions, 0u);
+        EXPECT_GE(stats.h2dBytes, weightBytes);
+        EXPECT_GT(stats.prefetches, 0u);
+        EXPECT_LE(stats.peakDeviceBytes, budget);
+    }
+
+    TEST(Offload, KeepsWeightsUpdatedOnDevice)
+    {
+        auto expected = runGemmChain(0, nullptr, true);
+        size_t weightBytes = 64 * 64 * sizeof(float);
+        size_t budget = 16 * 1024 + 2 * 16 * 64 * sizeof(float) + 2 * weightBytes;
+        OffloadManager::Stats stats;
+        auto result = runGemmChain(budget, &stats, true);
+        ASSERT_EQ(result.size(), expected.size());
+        for (size_t i = 0; i < result.size(); ++i)
+            EXPECT_FLOAT_EQ(result[i], expected[i]);
+        EXPECT_GT(stats.evictions, 0u);
+    }
+
+    TEST(Offload, BudgetTooSmall)
+    {
+        EXPECT_THROW(runGemmChain(1024, nullptr), Exception);
+        RuntimeObj::getInstance()->setMemoryBudget(0);
+    }
+
+} // namespace infini
@@ -0,0 +1,119 @@
+#pragma once
+#ifndef TEST_OPS_H
+#define TEST_OPS_H
+
+#include "core/kernel.h"
+#include "core/runtime.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+// Ops and kernels on OpType::Unknown shared by the runtime tests. Every test
+// file is its own executable and registers the kernels it needs.
+namespace infini
+{
+    class UnknownObj : public OperatorObj
+    {
+    public:
+        UnknownObj(GraphObj *graph, TensorVec inputs, Tensor Y)
+            : OperatorObj(OpType::Unknown, inputs, {Y})
+        {
+            IT_ASSERT(checkValid(graph));
+        }
+        UnknownObj(GraphObj *graph, Tensor X, Tensor Y)
+            : UnknownObj(graph, TensorVec{X}, Y) {}
+        // `numOutputs` new outputs shaped like the first input
+        UnknownObj(GraphObj *graph, TensorVec inputs, size_t numOutputs)
+            : OperatorObj(OpType::Unknown, inputs, TensorVec(numOutputs))
+        {
+            IT_ASSERT(checkValid(graph));
+        }
+        string toString() const override { return "Unknown"; }
+        Ref<void> createOpDesc(infiniopHandle_t) override { return nullptr; }
+        optional<vector<Shape>> inferShape() override
+        {
+            return vector<Shape>(outputs.size(), inputs[0]->getShape());
+        }
+        vector<DataType> inferDataType() const override
+        {
+            return vector<DataType>(outputs.size(), inputs[0]->getDataType());
+        }
+    };
+
+    // Logical start and end ticks of every DelayKernel launch
+    struct DelaySpans
+    {
+        std::mutex mtx;
+        size_t clock = 0;
+        std::unordered_map<const OperatorObj *, std::pair<size_t, size_t>> spans;
+
+        size_t tick()
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            return clock++;
+        }
+        void record(const OperatorObj *op, size_t start, size_t end)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            spans[op] = {start, end};
+        }
+    };
+    inline DelaySpans delaySpans;
+
+    // y = sum(inputs) + 1 after a fixed delay, standing in for a kernel that
+    // keeps its stream or worker busy
+    class DelayKernel : public Kernel
+    {
+        void compute(const Operator &op, const RuntimeObj *) const override
+        {
+            size_t start = delaySpans.tick();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            float sum = 1.0f;
+            for (auto &input : op->getInputs())
+                sum += *input->getRawDataPtr<float *>();
+            *op->getOutput(0)->getRawDataPtr<float *>() = sum;
+            delaySpans.record(op.get(), start, delaySpans.tick());
+        }
+    };
+
+    inline size_t nopLaunches = 0;
+
+    // Does nothing but count its launches
+    class NopKernel : public Kernel
+    {
+        void compute(const Operator &, const RuntimeObj *) const override { ++nopLaunches; }
+        void launch(const LaunchRecord &, void *, infinirtStream_t,
+                    const RuntimeObj *) const override { ++nopLaunches; }
+    };
+
+    class SlowKernel : public Kernel
+    {
+        void compute(const Operator &, const RuntimeObj *) const override
+        {
+            auto begin = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - begin < std::chrono::microseconds(200))
+                ;
+        }
+    };
+
+    class FastKernel : public Kernel
+    {
+        void compute(const Operator &, const RuntimeObj *) const override {}
+    };
+
+    inline size_t applicableChecks = 0;
+
+    // Only supports 1-D tensors
+    class VectorKernel : public Kernel
+    {
+        bool isApplicable(const Operator &op) const override
+        {
+            ++applicableChecks;
+            return op->getInput(0)->getRank() == 1;
+        }
+        void compute(const Operator &, const RuntimeObj *) const override {}
+    };
+} // namespace infini
+
+#endif // TEST_OPS_H
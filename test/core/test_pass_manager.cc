@@ -0,0 +1,519 @@
+#include "core/graph_passes.h"
+#include "core/runtime.h"
+#include "operators/Activation.h"
+#include "operators/Gemm.h"
+#include "operators/Transpose.h"
+#include "gtest/gtest.h"
+#include "test_ops.h"
+
+namespace infini
+{
+    // Appends its name to `order` and leaves the graph untouched
+    class RecordPass : public GraphPass
+    {
+        string name;
+        vector<string> &order;
+
+    public:
+        RecordPass(string name, vector<string> &order)
+            : name(std::move(name)), order(order) {}
+        string getName() const override { return name; }
+        bool run(GraphObj &) override
+        {
+            order.push_back(name);
+            return false;
+        }
+    };
+
+    // Removes the last op and its outputs
+    class DropLastOpPass : public GraphPass
+    {
+    public:
+        string getName() const override { return "drop-last-op"; }
+        bool run(GraphObj &graph) override
+        {
+            auto op = graph.getOperators().back();
+            graph.removeOperator(op);
+            for (auto &output : op->getOutputs())
+                graph.removeTensor(output);
+            return true;
+        }
+    };
+
+    // Removes an op's output but keeps the op
+    class BreakGraphPass : public GraphPass
+    {
+    public:
+        string getName() const override { return "break-graph"; }
+        bool run(GraphObj &graph) override
+        {
+            graph.removeTensor(graph.getOperators().front()->getOutput(0));
+            return true;
+        }
+    };
+
+    static Graph buildChain(const Runtime &runtime, Tensor &X, Tensor &Y)
+    {
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        X = g->addTensor({2, 4}, dtype);
+        auto W = g->addTensor({4, 4}, dtype);
+        Y = X;
+        for (int i = 0; i < 3; ++i)
+            Y = g->addOp<GemmObj>(Y, W, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        return g;
+    }
+
+    // Runs `g` and reads back `tensors`
+    static vector<vector<float>> runAndRead(const Runtime &runtime, const Graph &g,
+                                            const TensorVec &tensors)
+    {
+        runtime->run(g);
+        vector<vector<float>> data;
+        for (auto &tensor : tensors)
+        {
+            data.emplace_back(tensor->getElement());
+            tensor->copyToHost(runtime, data.back().data());
+        }
+        return data;
+    }
+
+    struct PlainAndOptimized
+    {
+        Graph plain, optimized;
+        TensorVec outputs; // of `optimized`, in the order `build` returned them
+        vector<vector<float>> plainResults, optimizedResults;
+    };
+
+    // Builds two copies of a graph with `build`, which fills in the inputs
+    // and returns the tensors to compare. One copy runs as built, the other
+    // after `optimize`, by default preparing it at O1.
+    static PlainAndOptimized
+    runPlainAndOptimized(const Runtime &runtime,
+                         const std::function<TensorVec(const Graph &)> &build,
+                         const std::function<void(const Graph &)> &optimize = nullptr)
+    {
+        PlainAndOptimized result;
+        result.plain = make_ref<GraphObj>(runtime);
+        auto plainOutputs = build(result.plain);
+        runtime->prepare(result.plain);
+        result.optimized = make_ref<GraphObj>(runtime);
+        result.outputs = build(result.optimized);
+        if (optimize)
+            optimize(result.optimized);
+        else
+            runtime->prepare(result.optimized, OptLevel::O1);
+        result.plainResults = runAndRead(runtime, result.plain, plainOutputs);
+        result.optimizedResults = runAndRead(runtime, result.optimized, result.outputs);
+        return result;
+    }
+
+    TEST(PassManager, OrderAndStats)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Tensor X, Y;
+        Graph g = buildChain(runtime, X, Y);
+
+        vector<string> order;
+        PassManager passes;
+        passes.addPass(make_ref<RecordPass>("a", order));
+        passes.addPass(make_ref<DropLastOpPass>());
+        passes.insertPass("a", make_ref<RecordPass>("b", order));
+        passes.addPass(make_ref<RecordPass>("c", order));
+        EXPECT_TRUE(passes.removePass("c"));
+        EXPECT_FALSE(passes.removePass("c"));
+        EXPECT_EQ(passes.getPassNames(), (vector<string>{"b", "a", "drop-last-op"}));
+        passes.setValidate(true);
+
+        auto report = g->optimize(passes);
+        EXPECT_EQ(order, (vector<string>{"b", "a"}));
+        ASSERT_EQ(report.passes.size(), 3u);
+        EXPECT_FALSE(report.passes[0].changed);
+        auto &drop = report.passes[2];
+        EXPECT_TRUE(drop.changed);
+        EXPECT_EQ(drop.opsBefore, 3u);
+        EXPECT_EQ(drop.opsAfter, 2u);
+        EXPECT_EQ(drop.tensorsBefore, 5u);
+        EXPECT_EQ(drop.tensorsAfter, 4u);
+        EXPECT_GE(report.totalMs, drop.ms);
+        EXPECT_NE(report.toString().find("drop-last-op"), string::npos);
+        // The output of the new last op is no longer read
+        EXPECT_TRUE(g->getOperators().back()->getOutput(0)->getTargets().empty());
+        EXPECT_TRUE(g->checkValid());
+    }
+
+    TEST(PassManager, ValidationNamesBrokenPass)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Tensor X, Y;
+        Graph g = buildChain(runtime, X, Y);
+        PassManager passes;
+        passes.addPass(make_ref<BreakGraphPass>());
+        passes.setValidate(true);
+        try
+        {
+            passes.run(*g);
+            FAIL() << "Broken graph was not detected";
+        }
+        catch (const std::exception &e)
+        {
+            EXPECT_NE(string(e.what()).find("break-graph"), string::npos) << e.what();
+        }
+
+        Graph h = buildChain(runtime, X, Y);
+        passes.setValidate(false);
+        EXPECT_NO_THROW(passes.run(*h));
+    }
+
+    TEST(PassManager, LevelsAddPasses)
+    {
+        // A higher level runs the passes of the lower one and more
+        auto lower = PassManager::create(OptLevel::O0).getPassNames();
+        auto higher = PassManager::create(OptLevel::O1).getPassNames();
+        EXPECT_NE(higher, lower);
+        EXPECT_GT(higher.size(), lower.size());
+        for (auto &name : lower)
+        {
+            EXPECT_NE(std::find(higher.begin(), higher.end(), name), higher.end())
+                << name;
+        }
+    }
+
+    TEST(PassManager, PrepareSelectsLevel)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Tensor X, Y;
+        Graph g = buildChain(runtime, X, Y);
+        g->addTensor({8}, DataType(INFINI_DTYPE_F32)); // never used
+        auto W = g->getOperators().front()->getInput(1);
+        g->dataMalloc();
+        vector<float> x(8, 1.0f), w(16, 0.5f), y(8);
+        X->copyFromHost(runtime, x.data());
+        W->copyFromHost(runtime, w.data());
+
+        EXPECT_TRUE(PassManager::create(OptLevel::O0).getPassNames().empty());
+        runtime->prepare(g);
+        EXPECT_EQ(g->getOptLevel(), OptLevel::O0);
+        EXPECT_EQ(g->getTensors().size(), 6u);
+
+        runtime->prepare(g, OptLevel::O1);
+        EXPECT_EQ(g->getOptLevel(), OptLevel::O1);
+        EXPECT_EQ(g->getTensors().size(), 5u);
+        auto &report = g->getPassReport();
+        ASSERT_EQ(report.passes.size(), 6u);
+        EXPECT_EQ(report.passes[0].name, "prune-dangling-tensors");
+        EXPECT_TRUE(report.passes[0].changed);
+        EXPECT_TRUE(g->checkValid());
+
+        runtime->run(g);
+        Y->copyToHost(runtime, y.data());
+        for (auto v : y)
+            EXPECT_FLOAT_EQ(v, 8.0f);
+
+        // Already optimized at this level: passes do not run again
+        runtime->prepare(g, OptLevel::O1);
+        EXPECT_TRUE(g->getPassReport().passes[0].changed);
+        EXPECT_NE(g->getPlan(), nullptr);
+    }
+
+    TEST(PassManager, FuseGemmActivation)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto build = [&](const Graph &g)
+        {
+            auto X = g->addTensor({4, 8}, dtype);
+            auto W = g->addTensor({8, 8}, dtype);
+            auto C = g->addTensor({1, 8}, dtype);
+            auto H = g->addOp<GemmObj>(X, W, nullptr, C, 1.0f, 1.0f)->getOutput(0);
+            H = g->addOp<ReluObj>(H, nullptr)->getOutput(0);
+            auto G = g->addOp<GemmObj>(H, W, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+            auto Y = g->addOp<ClipObj>(G, nullptr, -2.0f, 2.0f)->getOutput(0);
+            // G has two readers and stays unfused
+            auto Z = g->addOp<ReluObj>(G, nullptr)->getOutput(0);
+            g->dataMalloc();
+            vector<float> x(32), w(64), c(8);
+            for (size_t i = 0; i < x.size(); ++i)
+                x[i] = float(int(i % 7) - 3) * 0.25f;
+            for (size_t i = 0; i < w.size(); ++i)
+                w[i] = float(int(i % 5) - 2) * 0.5f;
+            std::iota(c.begin(), c.end(), -4.0f);
+            X->copyFromHost(runtime, x.data());
+            W->copyFromHost(runtime, w.data());
+            C->copyFromHost(runtime, c.data());
+            return TensorVec{Y, Z};
+        };
+
+        auto result = runPlainAndOptimized(runtime, build);
+        auto &fused = result.optimized;
+        EXPECT_EQ(result.plain->getOperators().size(), 5u);
+        ASSERT_EQ(fused->getOperators().size(), 4u);
+        auto first = as<GemmObj>(fused->getOperators().front());
+        EXPECT_EQ(first->getActivation().type, ActType::Relu);
+        EXPECT_NE(first->getBias(), nullptr);
+        EXPECT_EQ(as<GemmObj>(fused->getOperators()[1])->getActivation().type,
+                  ActType::None);
+        EXPECT_TRUE(fused->checkValid());
+        EXPECT_EQ(result.optimizedResults, result.plainResults);
+    }
+
+    TEST(PassManager, FuseKeepsGemmAccumulatingIntoY)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({4, 8}, dtype);
+        auto W = g->addTensor({8, 8}, dtype);
+        // beta scales the previous content of H, not of the Relu's output
+        auto H = g->addOp<GemmObj>(X, W, nullptr, nullptr, 1.0f, 1.0f)->getOutput(0);
+        auto Y = g->addOp<ReluObj>(H, nullptr)->getOutput(0);
+        g->setOutputs({Y});
+        EXPECT_FALSE(FuseGemmActivationPass().run(*g));
+        ASSERT_EQ(g->getOperators().size(), 2u);
+        EXPECT_EQ(as<GemmObj>(H->getSource())->getActivation().type, ActType::None);
+        EXPECT_EQ(Y->getSource()->getOpType(), OpType::Relu);
+    }
+
+    TEST(PassManager, FoldConstants)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto build = [&](const Graph &g)
+        {
+            auto X = g->addTensor({4, 8}, dtype);
+            auto W1 = g->addTensor({8, 8}, dtype);
+            auto W2 = g->addTensor({8, 8}, dtype);
+            W1->setWeight(true);
+            W2->setWeight(true);
+            // Weight-only chain: Relu(W1 * W2)
+            auto V = g->addOp<GemmObj>(W1, W2, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+            auto R = g->addOp<ReluObj>(V, nullptr)->getOutput(0);
+            auto Y = g->addOp<GemmObj>(X, R, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+            g->dataMalloc();
+            vector<float> x(32), w1(64), w2(64);
+            for (size_t i = 0; i < x.size(); ++i)
+                x[i] = float(int(i % 7) - 3);
+            for (size_t i = 0; i < w1.size(); ++i)
+            {
+                w1[i] = float(int(i % 5) - 2) * 0.5f;
+                w2[i] = float(int(i % 3) - 1);
+            }
+            X->copyFromHost(runtime, x.data());
+            W1->copyFromHost(runtime, w1.data());
+            W2->copyFromHost(runtime, w2.data());
+            return TensorVec{Y};
+        };
+
+        auto result = runPlainAndOptimized(runtime, build);
+        auto &folded = result.optimized;
+        ASSERT_EQ(folded->getOperators().size(), 1u);
+        auto R = folded->getOperators().front()->getInput(1);
+        EXPECT_TRUE(R->isWeight());
+        EXPECT_EQ(R->getSource(), nullptr);
+        // Only X, the folded constant and Y remain
+        EXPECT_EQ(folded->getTensors().size(), 3u);
+        EXPECT_FALSE(folded->getMemoryPlan().isPlanned(R));
+        auto &report = folded->getPassReport();
+        auto fold = std::find_if(report.passes.begin(), report.passes.end(),
+                                 [](const PassStats &pass)
+                                 { return pass.name == "fold-constants"; });
+        ASSERT_NE(fold, report.passes.end());
+        EXPECT_EQ(fold->opsBefore, 3u);
+        EXPECT_EQ(fold->opsAfter, 1u);
+        EXPECT_EQ(result.optimizedResults, result.plainResults);
+        // The folded constant survives further runs
+        EXPECT_EQ(runAndRead(runtime, folded, result.outputs), result.plainResults);
+    }
+
+    TEST(PassManager, KeepsGemmAccumulatingIntoY)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({4, 8}, dtype);
+        auto W1 = g->addTensor({8, 8}, dtype);
+        auto W2 = g->addTensor({8, 8}, dtype);
+        W1->setWeight(true);
+        W2->setWeight(true);
+        // beta scales the previous content of V and H: neither is a
+        // function of the inputs alone
+        auto V = g->addOp<GemmObj>(W1, W2, nullptr, nullptr, 1.0f, 1.0f)->getOutput(0);
+        auto H1 = g->addOp<GemmObj>(X, V, nullptr, nullptr, 1.0f, 1.0f)->getOutput(0);
+        auto H2 = g->addOp<GemmObj>(X, V, nullptr, nullptr, 1.0f, 1.0f)->getOutput(0);
+        g->setOutputs({H1, H2});
+        g->dataMalloc();
+        PassManager passes;
+        passes.addPass(make_ref<FoldConstantsPass>());
+        passes.addPass(make_ref<EliminateCommonSubexpressionsPass>());
+        auto report = g->optimize(passes);
+        EXPECT_FALSE(report.passes[0].changed);
+        EXPECT_FALSE(report.passes[1].changed);
+        EXPECT_EQ(g->getOperators().size(), 3u);
+        EXPECT_NE(V->getSource(), nullptr);
+    }
+
+    TEST(PassManager, EliminateDeadAndCommonCode)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto build = [&](const Graph &g)
+        {
+            auto X = g->addTensor({4, 8}, dtype);
+            auto W = g->addTensor({8, 8}, dtype);
+            auto unusedWeight = g->addTensor({8, 8}, dtype);
+            auto H1 = g->addOp<GemmObj>(X, W, nullptr, nullptr, 0.5f, 0.0f)->getOutput(0);
+            auto H2 = g->addOp<GemmObj>(X, W, nullptr, nullptr, 0.5f, 0.0f)->getOutput(0);
+            // Differs in alpha only: not a duplicate
+            auto H3 = g->addOp<GemmObj>(X, W, nullptr, nullptr, 2.0f, 0.0f)->getOutput(0);
+            auto R1 = g->addOp<ReluObj>(H1, nullptr)->getOutput(0);
+            auto R2 = g->addOp<ReluObj>(H2, nullptr)->getOutput(0);
+            auto Y = g->addOp<GemmObj>(R1, W, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+            auto Z = g->addOp<GemmObj>(R2, W, nullptr, H3, 1.0f, 1.0f)->getOutput(0);
+            // Nothing the outputs depend on
+            auto dead = g->addOp<GemmObj>(X, unusedWeight, nullptr, nullptr, 1.0f, 0.0f)
+                            ->getOutput(0);
+            g->addOp<ReluObj>(dead, nullptr);
+            g->setOutputs({Y, Z});
+            g->dataMalloc();
+            vector<float> x(32), w(64), u(64, 0.0f);
+            for (size_t i = 0; i < x.size(); ++i)
+                x[i] = float(int(i % 7) - 3);
+            for (size_t i = 0; i < w.size(); ++i)
+                w[i] = float(int(i % 5) - 2) * 0.5f;
+            X->copyFromHost(runtime, x.data());
+            W->copyFromHost(runtime, w.data());
+            unusedWeight->copyFromHost(runtime, u.data());
+            return TensorVec{Y, Z};
+        };
+        PassManager passes;
+        passes.addPass(make_ref<EliminateDeadCodePass>());
+        passes.addPass(make_ref<EliminateCommonSubexpressionsPass>());
+        passes.setValidate(true);
+        PassReport report;
+        auto optimize = [&](const Graph &g)
+        {
+            report = g->optimize(passes);
+            runtime->prepare(g);
+        };
+
+        auto result = runPlainAndOptimized(runtime, build, optimize);
+        ASSERT_EQ(report.passes.size(), 2u);
+        auto &dce = report.passes[0];
+        EXPECT_TRUE(dce.changed);
+        EXPECT_EQ(dce.opsBefore, 9u);
+        EXPECT_EQ(dce.opsAfter, 7u);
+        auto &cse = report.passes[1];
+        EXPECT_TRUE(cse.changed);
+        EXPECT_EQ(cse.opsAfter, 5u);
+        EXPECT_EQ(cse.tensorsBefore - cse.tensorsAfter, 2u);
+        // Both outputs now read the merged Relu
+        auto Y = result.outputs[0], Z = result.outputs[1];
+        auto R = Y->getSource()->getInput(0);
+        EXPECT_EQ(Z->getSource()->getInput(0), R);
+        EXPECT_EQ(R->getTargets().size(), 2u);
+        EXPECT_LT(result.optimized->getMemoryPlan().arenaSize,
+                  result.plain->getMemoryPlan().arenaSize);
+        EXPECT_EQ(result.optimizedResults, result.plainResults);
+    }
+
+    TEST(PassManager, AbsorbTranspose)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto build = [&](const Graph &g)
+        {
+            auto X = g->addTensor({4, 8}, dtype);
+            auto W = g->addTensor({16, 8}, dtype);
+            auto T = g->addOp<TransposeObj>(W, nullptr, vector<int>{1, 0})->getOutput(0);
+            auto Y = g->addOp<GemmObj>(X, T, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+            // Also read by a Relu, so this Transpose has to stay
+            auto U = g->addOp<TransposeObj>(Y, nullptr, vector<int>{1, 0})->getOutput(0);
+            auto Z = g->addOp<GemmObj>(U, X, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+            auto R = g->addOp<ReluObj>(U, nullptr)->getOutput(0);
+            g->setOutputs({Z, R});
+            g->dataMalloc();
+            vector<float> x(32), w(128);
+            for (size_t i = 0; i < x.size(); ++i)
+                x[i] = float(int(i % 7) - 3);
+            for (size_t i = 0; i < w.size(); ++i)
+                w[i] = float(int(i % 5) - 2) * 0.5f;
+            X->copyFromHost(runtime, x.data());
+            W->copyFromHost(runtime, w.data());
+            return TensorVec{Z, R};
+        };
+
+        auto result = runPlainAndOptimized(runtime, build);
+        ASSERT_EQ(result.optimized->getOperators().size(), 4u);
+        auto Z = result.outputs[0], R = result.outputs[1];
+        // Z = Y^T * X reads Y in place, Y = X * W^T reads W in place
+        auto second = as<GemmObj>(Z->getSource());
+        EXPECT_TRUE(second->getTransA());
+        auto first = as<GemmObj>(second->getInput(0)->getSource());
+        EXPECT_FALSE(first->getTransA());
+        EXPECT_TRUE(first->getTransB());
+        EXPECT_EQ(first->getInput(1)->getShape(), (Shape{16, 8}));
+        EXPECT_EQ(R->getSource()->getInput(0)->getSource()->getOpType(),
+                  OpType::Transpose);
+        EXPECT_EQ(result.optimizedResults, result.plainResults);
+    }
+
+    TEST(PassManager, DeadCodeKeepsOutputsOfLiveOps)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({2, 4}, DataType(INFINI_DTYPE_F32));
+        // Only the first of the two outputs is read
+        auto pair = g->addOp<UnknownObj>(TensorVec{X}, 2);
+        auto Y = g->addOp<UnknownObj>(pair->getOutput(0), nullptr)->getOutput(0);
+        g->setOutputs({Y});
+        EXPECT_FALSE(EliminateDeadCodePass().run(*g));
+        EXPECT_EQ(g->getTensors().size(), 4u);
+        EXPECT_EQ(pair->getOutput(1)->getSource(), pair);
+        EXPECT_TRUE(g->checkValid());
+    }
+
+    TEST(PassManager, ReplaceAllUsesKeepsSharedSource)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto X = g->addTensor({2, 4}, dtype);
+        auto Z = g->addTensor({2, 4}, dtype);
+        auto pair = g->addOp<UnknownObj>(TensorVec{X}, 2);
+        auto join = g->addOp<UnknownObj>(pair->getOutputs(), nullptr);
+        g->replaceAllUses(pair->getOutput(0), Z);
+        // join still reads the second output of pair
+        EXPECT_EQ(join->getInput(0), Z);
+        auto preds = join->getPredecessors();
+        auto succs = pair->getSuccessors();
+        EXPECT_NE(std::find(preds.begin(), preds.end(), pair), preds.end());
+        EXPECT_NE(std::find(succs.begin(), succs.end(), join), succs.end());
+
+        g->replaceAllUses(pair->getOutput(1), Z);
+        EXPECT_TRUE(join->getPredecessors().empty());
+        EXPECT_TRUE(pair->getSuccessors().empty());
+    }
+
+} // namespace infini
@@ -0,0 +1,74 @@
+#include "core/pipeline_executor.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    TEST(PipelineExecutor, PartitionBalancesCost)
+    {
+        EXPECT_EQ(PipelineExecutor::partition({1, 1, 1, 1, 4}, 2), (vector<size_t>{0, 4}));
+        EXPECT_EQ(PipelineExecutor::partition({1, 2, 3, 4, 5, 6, 7, 8, 9}, 3),
+                  (vector<size_t>{0, 5, 7}));
+        EXPECT_EQ(PipelineExecutor::partition({5, 5, 5}, 3), (vector<size_t>{0, 1, 2}));
+    }
+
+    TEST(PipelineExecutor, MicroBatchesMatchSingleRun)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        const size_t batch = 8, width = 16, numLayers = 4;
+        auto X = g->addTensor({batch, width}, dtype);
+        Tensor Y = X;
+        TensorVec weights;
+        for (size_t l = 0; l < numLayers; ++l)
+        {
+            weights.push_back(g->addTensor({width, width}, dtype));
+            Y = g->addOp<GemmObj>(Y, weights.back(), nullptr, nullptr, 0.25f, 0.0f)
+                    ->getOutput(0);
+        }
+        g->dataMalloc();
+        for (size_t l = 0; l < numLayers; ++l)
+        {
+            vector<float> w(width * width);
+            for (size_t i = 0; i < w.size(); ++i)
+                w[i] = float((i + l) % 5) - 2.0f;
+            weights[l]->copyFromHost(runtime, w.data());
+        }
+        vector<float> x(batch * width);
+        std::iota(x.begin(), x.end(), -32.0f);
+        X->copyFromHost(runtime, x.data());
+        runtime->run(g);
+        vector<float> expected(Y->getElement());
+        Y->copyToHost(runtime, expected.data());
+
+        PipelineExecutor::Config config;
+        config.numStages = 2;
+        config.numMicroBatches = 4;
+        config.devices = {0, 1};
+        PipelineExecutor pipeline(runtime, g, {X}, config);
+        EXPECT_EQ(pipeline.getStageGraph(0)->getOperators().size(), 2u);
+        EXPECT_EQ(pipeline.getStageGraph(1)->getTensors().front()->getShape(),
+                  (Shape{batch / 4, width}));
+        for (int iter = 0; iter < 2; ++iter)
+        {
+            pipeline.run({{X, x.data()}});
+            vector<float> y(Y->getElement());
+            pipeline.getOutput(Y, y.data());
+            EXPECT_EQ(y, expected);
+        }
+
+        const auto &stats = pipeline.getStats();
+        ASSERT_EQ(stats.stages.size(), 2u);
+        EXPECT_EQ(stats.stages[1].firstOp, 2u);
+        for (auto &stage : stats.stages)
+        {
+            EXPECT_GT(stage.busyMs, 0);
+            EXPECT_LE(stage.busyMs, stats.wallMs);
+            EXPECT_NEAR(stage.busyMs + stage.bubbleMs, stats.wallMs, 1e-9);
+        }
+    }
+
+} // namespace infini
@@ -0,0 +1,137 @@
+#include "core/runtime.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    static vector<float> reference(const vector<float> &a, const vector<float> &b,
+                                   size_t m, size_t k, size_t n)
+    {
+        vector<float> y(m * n, 0.0f);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+                for (size_t p = 0; p < k; ++p)
+                    y[i * n + j] += a[i * k + p] * b[p * n + j];
+        return y;
+    }
+
+    TEST(PlanCache, IncrementalShapeInference)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({4, 8}, dtype);
+        auto B = g->addTensor({8, 8}, dtype);
+        auto X = g->addTensor({2, 8}, dtype);
+        auto H = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        auto Y = g->addOp<GemmObj>(H, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        auto Z = g->addOp<GemmObj>(X, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+
+        A->setShape({6, 8});
+        EXPECT_EQ(g->shape_infer({A}), 2u);
+        EXPECT_EQ(Y->getShape(), (Shape{6, 8}));
+        EXPECT_EQ(Z->getShape(), (Shape{2, 8}));
+        // Nothing downstream changes shape
+        X->setShape({2, 8});
+        EXPECT_EQ(g->shape_infer({X}), 1u);
+    }
+
+    TEST(PlanCache, SwitchingBackReusesPreparedShape)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({4, 8}, dtype);
+        auto B = g->addTensor({8, 8}, dtype);
+        auto C = g->addTensor({8, 4}, dtype);
+        auto H = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        auto Y = g->addOp<GemmObj>(H, C, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        g->dataMalloc();
+        vector<float> b(B->getElement()), c(C->getElement());
+        std::iota(b.begin(), b.end(), -8.0f);
+        std::iota(c.begin(), c.end(), 1.0f);
+        B->copyFromHost(runtime, b.data());
+        C->copyFromHost(runtime, c.data());
+
+        auto check = [&](size_t m)
+        {
+            vector<float> a(m * 8), y(m * 4);
+            std::iota(a.begin(), a.end(), float(m));
+            A->copyFromHost(runtime, a.data());
+            runtime->run(g);
+            Y->copyToHost(runtime, y.data());
+            EXPECT_EQ(y, reference(reference(a, b, m, 8, 8), c, m, 8, 4)) << "m=" << m;
+        };
+
+        runtime->prepare(g);
+        auto plan4 = g->getPlan();
+        check(4);
+
+        g->setInputShapes({{A, {6, 8}}});
+        EXPECT_EQ(g->getPlan(), nullptr);
+        EXPECT_EQ(Y->getShape(), (Shape{6, 4}));
+        runtime->prepare(g);
+        auto plan6 = g->getPlan();
+        check(6);
+
+        // Alternating between seen shapes never re-plans
+        auto &cache = g->getPlanCache();
+        size_t descMisses = runtime->getDescriptorCache().getMisses();
+        size_t hits = cache.getHits();
+        for (int i = 0; i < 3; ++i)
+        {
+            g->setInputShapes({{A, {4, 8}}});
+            EXPECT_EQ(g->getPlan(), plan4);
+            EXPECT_EQ(H->getShape(), (Shape{4, 8}));
+            check(4);
+            g->setInputShapes({{A, {6, 8}}});
+            EXPECT_EQ(g->getPlan(), plan6);
+            check(6);
+        }
+        EXPECT_EQ(cache.getHits(), hits + 6);
+        EXPECT_EQ(cache.size(), 2u);
+        EXPECT_EQ(runtime->getDescriptorCache().getMisses(), descMisses);
+
+        // Structural changes invalidate every entry
+        g->addOp<GemmObj>(Y, g->addTensor({4, 4}, dtype), nullptr, nullptr, 1.0f, 0.0f);
+        EXPECT_EQ(cache.size(), 0u);
+    }
+
+    TEST(PlanCache, RestoreKeepsReboundWeights)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({4, 8}, dtype);
+        auto B = g->addTensor({8, 4}, dtype);
+        B->setWeight(true);
+        auto Y = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        g->dataMalloc();
+        vector<float> b(B->getElement());
+        std::iota(b.begin(), b.end(), -8.0f);
+        B->copyFromHost(runtime, b.data());
+        runtime->prepare(g);
+        g->setInputShapes({{A, {6, 8}}});
+        runtime->prepare(g);
+
+        // New weights bound while the graph runs with the second shape
+        vector<float> updated(B->getElement());
+        std::iota(updated.begin(), updated.end(), 1.0f);
+        B->bindExternal(updated.data());
+        g->setInputShapes({{A, {4, 8}}});
+        EXPECT_EQ(B->getRawDataPtr<void *>(), updated.data());
+        vector<float> a(4 * 8), y(4 * 4);
+        std::iota(a.begin(), a.end(), 0.0f);
+        A->copyFromHost(runtime, a.data());
+        runtime->run(g);
+        Y->copyToHost(runtime, y.data());
+        EXPECT_EQ(y, reference(a, updated, 4, 8, 4));
+    }
+
+} // namespace infini
@@ -0,0 +1,186 @@
+#include "core/runtime.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    TEST(Runtime, WorkspaceIsSizedFromGraph)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({4, 8}, dtype);
+        auto B = g->addTensor({8, 4}, dtype);
+        auto op = g->addOp<GemmObj>(A, B, nullptr, nullptr);
+        g->dataMalloc();
+        size_t required = op->getWorkspaceSize(runtime.get());
+        EXPECT_EQ(g->getWorkspaceSize(), required);
+        runtime->run(g);
+        EXPECT_GE(runtime->getWorkspaceSize(), required);
+        // No more than what the graph asked for
+        EXPECT_LT(runtime->getWorkspaceSize(), size_t(1) << 20);
+    }
+
+    TEST(Runtime, DescriptorsAreCachedAcrossRuns)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        auto &cache = runtime->getDescriptorCache();
+        size_t before = cache.getMisses();
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({4, 8}, dtype);
+        auto B = g->addTensor({8, 8}, dtype);
+        auto C = g->addTensor({8, 8}, dtype);
+        auto Y = g->addOp<GemmObj>(A, B, nullptr, nullptr)->getOutput(0);
+        g->addOp<GemmObj>(Y, C, nullptr, nullptr);
+        g->dataMalloc();
+        runtime->run(g);
+        // Both Gemms have the same key and share one descriptor
+        size_t created = cache.getMisses();
+        EXPECT_EQ(created, before + 1);
+        runtime->run(g);
+        runtime->run(g);
+        EXPECT_EQ(cache.getMisses(), created);
+
+        A->setShape({2, 8});
+        g->shape_infer();
+        runtime->run(g);
+        EXPECT_EQ(cache.getMisses(), created + 1);
+        runtime->run(g);
+        EXPECT_EQ(cache.getMisses(), created + 1);
+    }
+
+    TEST(Runtime, DescriptorCacheEvictsLeastRecentlyUsed)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DescriptorCache cache;
+        cache.setCapacity(2);
+        int created = 0;
+        auto get = [&](int id)
+        {
+            auto weak = std::weak_ptr<void>(cache.getOrCreate(
+                DescriptorKey(OpType::Gemm).add(id), [&]
+                { ++created; return make_ref<int>(id); }));
+            return weak;
+        };
+        auto first = get(1);
+        get(2);
+        get(1); // 2 is now the least recently used
+        get(3);
+        EXPECT_EQ(cache.size(), 2u);
+        EXPECT_EQ(cache.getEvictions(), 1u);
+        EXPECT_FALSE(first.expired());
+        EXPECT_EQ(created, 3);
+        get(1);
+        EXPECT_EQ(created, 3);
+        // Unreferenced evicted descriptors are destroyed
+        auto second = get(2);
+        EXPECT_EQ(created, 4);
+        get(4);
+        get(1);
+        EXPECT_TRUE(second.expired());
+        EXPECT_EQ(cache.getEvictions(), 4u);
+
+        cache.setCapacity(1);
+        EXPECT_EQ(cache.size(), 1u);
+        EXPECT_THROW(cache.setCapacity(0), Exception);
+    }
+
+    TEST(Runtime, WorkspaceIsPerThreadContext)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        void *mainWorkspace = runtime->getWorkspace(1024);
+        void *otherWorkspace = nullptr;
+        std::thread worker([&]()
+                           {
+            runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+            otherWorkspace = runtime->getWorkspace(1024); });
+        worker.join();
+        EXPECT_NE(mainWorkspace, otherWorkspace);
+        EXPECT_EQ(runtime->getWorkspace(512), mainWorkspace);
+        EXPECT_GE(runtime->getWorkspaceSize(), 1024u);
+
+        // A worker that releases its context hands the workspace back
+        size_t allocated = runtime->getAllocator().getAllocatedBytes();
+        std::thread released([&]()
+                             {
+            runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+            runtime->getWorkspace(1 << 20);
+            runtime->releaseThreadContext();
+            EXPECT_EQ(runtime->getCurrentStream(), nullptr); });
+        released.join();
+        EXPECT_EQ(runtime->getAllocator().getAllocatedBytes(), allocated);
+    }
+
+    TEST(Runtime, HostCopiesReuseStagingBuffers)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto t = g->addTensor({32, 32}, DataType(INFINI_DTYPE_F32));
+        t->dataMalloc(runtime);
+
+        auto &pool = runtime->getStagingPool();
+        size_t misses = pool.getMisses();
+        vector<float> src(t->getElement()), dst(t->getElement());
+        for (int iter = 0; iter < 4; ++iter)
+        {
+            std::iota(src.begin(), src.end(), float(iter));
+            if (iter % 2)
+                t->copyFromHostAsync(runtime, src.data());
+            else
+                t->copyFromHost(runtime, src.data());
+            t->copyToHost(runtime, dst.data());
+            EXPECT_EQ(src, dst);
+        }
+        // Only the first transfer needed a new pinned buffer
+        EXPECT_LE(pool.getMisses(), misses + 1);
+        EXPECT_GE(pool.getHits(), 7u);
+
+        vector<float> asyncDst(t->getElement());
+        t->copyToHostAsync(runtime, asyncDst.data());
+        runtime->streamSynchronize(runtime->getCurrentStream());
+        EXPECT_EQ(asyncDst, dst);
+    }
+
+    TEST(Runtime, ExternalBuffersAreUsedInPlace)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto A = g->addTensor({2, 3}, dtype);
+        auto B = g->addTensor({3, 2}, dtype);
+        auto Y = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+
+        vector<float> aData{1, 2, 3, 4, 5, 6}, bData{1, 0, 0, 1, 1, 1};
+        vector<float> yData(4, -1.0f);
+        A->bindExternal(aData.data(), MemoryLocation::Host);
+        B->bindExternal(bData.data(), MemoryLocation::Host);
+        Y->bindExternal(yData.data(), MemoryLocation::Host);
+        g->dataMalloc();
+        EXPECT_TRUE(Y->isExternal());
+        EXPECT_EQ(Y->getRawDataPtr<float *>(), yData.data());
+        EXPECT_EQ(g->getMemoryPlan().pinnedSize, 0u);
+
+        runtime->run(g);
+        runtime->streamSynchronize(runtime->getCurrentStream());
+        EXPECT_EQ(yData, (vector<float>{4, 5, 10, 11}));
+
+        // Rebinding the output redirects the next run
+        vector<float> yData2(4, 0.0f);
+        Y->bindExternal(yData2.data(), MemoryLocation::Host);
+        runtime->run(g);
+        EXPECT_EQ(yData2, yData);
+    }
+} // namespace infini
@@ -0,0 +1,102 @@
+#include "core/runtime.h"
+#include "utils/safetensors.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+
+namespace infini
+{
+    namespace
+    {
+        string writeSafeTensors(const string &header, const vector<float> &data)
+        {
+            string path = testing::TempDir() + "weights.safetensors";
+            std::ofstream out(path, std::ios::binary);
+            uint64_t size = header.size();
+            for (int i = 0; i < 8; ++i)
+                out.put(static_cast<char>((size >> (8 * i)) & 0xff));
+            out << header;
+            out.write(reinterpret_cast<const char *>(data.data()),
+                      data.size() * sizeof(float));
+            return path;
+        }
+    } // namespace
+
+    TEST(SafeTensors, ParseHeader)
+    {
+        string header = R"({"__metadata__":{"format":"pt"},)"
+                        R"("w":{"dtype":"F16","shape":[2, 3],"data_offsets":[0,12]},)"
+                        R"("b":{"shape":[],"dtype":"I64","data_offsets":[12,20]}})";
+        auto entries = SafeTensorsLoader::parseHeader(header.data(), header.size());
+        ASSERT_EQ(entries.size(), 2u);
+        EXPECT_EQ(entries[0].name, "w");
+        EXPECT_EQ(entries[0].dtype, DataType(INFINI_DTYPE_F16));
+        EXPECT_EQ(entries[0].shape, (Shape{2, 3}));
+        EXPECT_EQ(entries[1].shape, Shape{});
+        EXPECT_EQ(entries[1].begin, 12u);
+        EXPECT_EQ(entries[1].end, 20u);
+
+        // The runtime's single F8 type is E4M3
+        string e4m3 = R"({"w":{"dtype":"F8_E4M3","shape":[4],"data_offsets":[0,4]}})";
+        entries = SafeTensorsLoader::parseHeader(e4m3.data(), e4m3.size());
+        EXPECT_EQ(entries[0].dtype, DataType(INFINI_DTYPE_F8));
+        string e5m2 = R"({"w":{"dtype":"F8_E5M2","shape":[4],"data_offsets":[0,4]}})";
+        EXPECT_THROW(SafeTensorsLoader::parseHeader(e5m2.data(), e5m2.size()), Exception);
+    }
+
+    TEST(SafeTensors, LoadZeroCopyOnCpu)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        vector<float> data{1, 2, 3, 4, 5, 6, 7, 8};
+        string path = writeSafeTensors(
+            R"({"a":{"dtype":"F32","shape":[2,2],"data_offsets":[0,16]},)"
+            R"("b":{"dtype":"F32","shape":[4],"data_offsets":[16,32]}}  )",
+            data);
+
+        Graph g = make_ref<GraphObj>(runtime);
+        auto weights = SafeTensorsLoader::load(g, path);
+        std::remove(path.c_str());
+        ASSERT_EQ(weights.size(), 2u);
+        auto a = weights.at("a"), b = weights.at("b");
+        EXPECT_EQ(a->getShape(), (Shape{2, 2}));
+        EXPECT_EQ(g->getTensors().size(), 2u);
+        // The mapping outlives the unlinked file while tensors reference it
+        vector<float> host(4);
+        b->copyToHost(runtime, host.data());
+        EXPECT_EQ(host, (vector<float>{5, 6, 7, 8}));
+        a->copyToHost(runtime, host.data());
+        EXPECT_EQ(host, (vector<float>{1, 2, 3, 4}));
+        // Weights keep their storage through dataMalloc
+        void *ptr = a->getRawDataPtr<void *>();
+        g->dataMalloc();
+        EXPECT_EQ(a->getRawDataPtr<void *>(), ptr);
+    }
+
+    TEST(SafeTensors, RejectsBadOffsets)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        string path = writeSafeTensors(
+            R"({"a":{"dtype":"F32","shape":[2],"data_offsets":[0,8]},)"
+            R"("b":{"dtype":"F32","shape":[4],"data_offsets":[8,12]}})",
+            {1, 2, 3, 4});
+        Graph g = make_ref<GraphObj>(runtime);
+        EXPECT_THROW(SafeTensorsLoader::load(g, path), Exception);
+        // The valid entry before the bad one is not left in the graph
+        EXPECT_TRUE(g->getTensors().empty());
+        std::remove(path.c_str());
+
+        // A header size near 2^64 must not wrap around the bounds check
+        path = testing::TempDir() + "huge_header.safetensors";
+        {
+            std::ofstream out(path, std::ios::binary);
+            for (int i = 0; i < 8; ++i)
+                out.put(static_cast<char>(0xff));
+            out << "{}";
+        }
+        EXPECT_THROW(SafeTensorsLoader::load(g, path), Exception);
+        std::remove(path.c_str());
+    }
+} // namespace infini
@@ -0,0 +1,86 @@
+#include "core/stream_executor.h"
+#include "gtest/gtest.h"
+#include "test_ops.h"
+#include <set>
+
+REGISTER_KERNEL(INFINI_DEVICE_CPU, OpType::Unknown, DelayKernel, "DelayKernel_CPU");
+
+namespace infini
+{
+    TEST(MultiStreamExecutor, BranchesOverlap)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({1}, DataType(INFINI_DTYPE_F32));
+        // Four independent two-op branches joined at the end, like Q/K/V/O
+        TensorVec branches;
+        for (int i = 0; i < 4; ++i)
+        {
+            auto t = g->addOp<UnknownObj>(TensorVec{X}, nullptr)->getOutput(0);
+            branches.push_back(g->addOp<UnknownObj>(TensorVec{t}, nullptr)->getOutput(0));
+        }
+        auto Y = g->addOp<UnknownObj>(branches, nullptr)->getOutput(0);
+        g->dataMalloc();
+        float x = 1.0f;
+        X->copyFromHost(runtime, &x);
+
+        MultiStreamExecutor executor(runtime, 4);
+        executor.run(g);
+        float y = 0.0f;
+        Y->copyFromHost(runtime, &y);
+        delaySpans.spans.clear();
+        executor.run(g);
+        Y->copyToHost(runtime, &y);
+        EXPECT_FLOAT_EQ(y, 4 * (x + 2) + 1);
+
+        // Ops of different branches actually ran at the same time
+        const auto &ops = g->getOperators();
+        ASSERT_EQ(delaySpans.spans.size(), ops.size());
+        auto overlap = [&](size_t i, size_t j)
+        {
+            auto [start1, end1] = delaySpans.spans.at(ops[i].get());
+            auto [start2, end2] = delaySpans.spans.at(ops[j].get());
+            return start1 < end2 && start2 < end1;
+        };
+        bool overlapped = false;
+        for (size_t i = 0; i < 8; ++i)
+            for (size_t j = i + 1; j < 8; ++j)
+                overlapped |= i / 2 != j / 2 && overlap(i, j);
+        EXPECT_TRUE(overlapped);
+
+        // Every branch owns a stream and only the join waits across streams
+        const auto &schedule = executor.getSchedule();
+        std::set<int> heads;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            heads.insert(schedule.streamOf[2 * i]);
+            EXPECT_EQ(schedule.streamOf[2 * i + 1], schedule.streamOf[2 * i]);
+            EXPECT_TRUE(schedule.waits[2 * i].empty());
+            EXPECT_TRUE(schedule.waits[2 * i + 1].empty());
+        }
+        EXPECT_EQ(heads.size(), 4u);
+        for (auto &ops : schedule.streamOps)
+            EXPECT_GE(ops.size(), 2u);
+        // Once per branch the join does not continue
+        EXPECT_EQ(schedule.waits[8].size(), 3u);
+        EXPECT_EQ(schedule.numCrossEdges, 3u);
+    }
+
+    TEST(MultiStreamExecutor, ChainStaysOnOneStream)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({1}, DataType(INFINI_DTYPE_F32));
+        for (int i = 0; i < 4; ++i)
+            x = g->addOp<UnknownObj>(TensorVec{x}, nullptr)->getOutput(0);
+        g->dataMalloc();
+        auto schedule = MultiStreamExecutor::buildSchedule(g->getOperators(), 3);
+        EXPECT_EQ(schedule.numCrossEdges, 0u);
+        EXPECT_EQ(schedule.streamOps[0].size(), 4u);
+    }
+
+} // namespace infini
@@ -0,0 +1,127 @@
+#include "core/tensor_parallel.h"
+#include "operators/Gemm.h"
+#include "gtest/gtest.h"
+#include <numeric>
+
+namespace infini
+{
+    TEST(Collective, SharedMemoryAllReduceAndAllGather)
+    {
+        const int worldSize = 4;
+        auto comms = SharedMemoryCommunicator::createGroup(worldSize);
+        vector<vector<float>> reduced(worldSize), gathered(worldSize);
+        vector<std::thread> threads;
+        for (int rank = 0; rank < worldSize; ++rank)
+        {
+            threads.emplace_back([&, rank]
+                                 {
+                RuntimeObj::getInstance()->initThreadContext(INFINI_DEVICE_CPU, 0);
+                auto stream = RuntimeObj::getInstance()->getCurrentStream();
+                reduced[rank] = {float(rank), float(rank * 10)};
+                comms[rank]->allReduceSum(reduced[rank].data(), 2,
+                                          DataType(INFINI_DTYPE_F32), stream);
+                float send = float(rank + 1);
+                gathered[rank].resize(worldSize);
+                comms[rank]->allGather(&send, gathered[rank].data(), sizeof(float),
+                                       stream); });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        for (int rank = 0; rank < worldSize; ++rank)
+        {
+            EXPECT_EQ(reduced[rank], (vector<float>{6.0f, 60.0f}));
+            EXPECT_EQ(gathered[rank], (vector<float>{1.0f, 2.0f, 3.0f, 4.0f}));
+        }
+    }
+
+    class TensorParallelTest
+        : public ::testing::TestWithParam<TensorParallelExecutor::ShardMode>
+    {
+    };
+
+    TEST_P(TensorParallelTest, MatchesSingleRank)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto X = g->addTensor({4, 8}, dtype);
+        auto W1 = g->addTensor({8, 16}, dtype);
+        auto W2 = g->addTensor({16, 8}, dtype);
+        W1->setWeight(true);
+        W2->setWeight(true);
+        auto H = g->addOp<GemmObj>(X, W1, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        auto Y = g->addOp<GemmObj>(H, W2, nullptr, nullptr, 0.5f, 0.0f)->getOutput(0);
+        g->dataMalloc();
+        vector<float> x(X->getElement()), w1(W1->getElement()), w2(W2->getElement());
+        for (size_t i = 0; i < x.size(); ++i)
+            x[i] = float(i % 7) - 3.0f;
+        for (size_t i = 0; i < w1.size(); ++i)
+            w1[i] = float(i % 5) - 2.0f;
+        for (size_t i = 0; i < w2.size(); ++i)
+            w2[i] = float(i % 3) - 1.0f;
+        W1->copyFromHost(runtime, w1.data());
+        W2->copyFromHost(runtime, w2.data());
+        X->copyFromHost(runtime, x.data());
+        runtime->run(g);
+        vector<float> expected(Y->getElement());
+        Y->copyToHost(runtime, expected.data());
+
+        TensorParallelExecutor::Config config;
+        config.worldSize = 2;
+        config.mode = GetParam();
+        TensorParallelExecutor executor(runtime, g, config);
+        EXPECT_EQ(executor.getNumSharded(), 2u);
+        auto opType = config.mode == TensorParallelExecutor::ShardMode::Column
+                          ? OpType::AllGather
+                          : OpType::AllReduceSum;
+        const auto &ops = executor.getRankGraph(1)->getOperators();
+        EXPECT_EQ(std::count_if(ops.begin(), ops.end(), [&](const Operator &op)
+                                { return op->getOpType() == opType; }),
+                  2);
+        for (int iter = 0; iter < 2; ++iter)
+        {
+            executor.run({{X, x.data()}});
+            vector<float> y(Y->getElement());
+            executor.getOutput(Y, y.data());
+            EXPECT_EQ(y, expected);
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ShardModes, TensorParallelTest,
+                             ::testing::Values(TensorParallelExecutor::ShardMode::Column,
+                                               TensorParallelExecutor::ShardMode::Row));
+
+    TEST(TensorParallel, ShardsOnlyFlaggedWeights)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto X = g->addTensor({4, 8}, dtype);
+        // Allocated but fed on every run, not a weight
+        auto B = g->addTensor({8, 4}, dtype);
+        auto Y = g->addOp<GemmObj>(X, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        g->dataMalloc();
+        vector<float> x(X->getElement()), b(B->getElement());
+        std::iota(x.begin(), x.end(), -4.0f);
+        std::iota(b.begin(), b.end(), 1.0f);
+        X->copyFromHost(runtime, x.data());
+        B->copyFromHost(runtime, b.data());
+        runtime->run(g);
+        vector<float> expected(Y->getElement());
+        Y->copyToHost(runtime, expected.data());
+
+        TensorParallelExecutor::Config config;
+        config.worldSize = 2;
+        TensorParallelExecutor executor(runtime, g, config);
+        EXPECT_EQ(executor.getNumSharded(), 0u);
+        executor.run({{X, x.data()}, {B, b.data()}});
+        vector<float> y(Y->getElement());
+        executor.getOutput(Y, y.data());
+        EXPECT_EQ(y, expected);
+    }
+
+} // namespace infini
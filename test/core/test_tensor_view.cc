@@ -0,0 +1,97 @@
+#include "core/runtime.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    TEST(TensorView, SharesStorage)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        auto X = make_ref<TensorObj>(Shape{2, 3, 4}, DataType(INFINI_DTYPE_F32));
+        X->dataMalloc(runtime);
+        vector<float> x(24);
+        std::iota(x.begin(), x.end(), 0.0f);
+        X->copyFromHost(runtime, x.data());
+        auto base = X->getRawDataPtr<float *>();
+        EXPECT_TRUE(X->isContiguous());
+
+        auto T = X->transpose({0, 2, 1});
+        EXPECT_EQ(T->getShape(), (Shape{2, 4, 3}));
+        EXPECT_EQ(T->getStride(), (Stride{12, 1, 4}));
+        EXPECT_EQ(T->getRawDataPtr<float *>(), base);
+        EXPECT_FALSE(T->isContiguous());
+        EXPECT_EQ(T->getStorageSize(), X->getStorageSize());
+
+        auto S = X->slice(1, 1, 3);
+        EXPECT_EQ(S->getShape(), (Shape{2, 2, 4}));
+        EXPECT_EQ(S->getStride(), X->getStride());
+        EXPECT_EQ(S->getRawDataPtr<float *>(), base + 4);
+        EXPECT_FALSE(S->isContiguous());
+        // The first batch alone is contiguous again
+        auto B = X->slice(0, 1, 2);
+        EXPECT_TRUE(B->isContiguous());
+        auto R = B->reshape({3, 4});
+        EXPECT_EQ(R->getRawDataPtr<float *>(), base + 12);
+        vector<float> r(12);
+        R->copyToHost(runtime, r.data());
+        EXPECT_EQ(r, vector<float>(x.begin() + 12, x.end()));
+
+        // Writes through a view land in the source
+        vector<float> ones(12, 1.0f);
+        R->copyFromHost(runtime, ones.data());
+        X->copyToHost(runtime, x.data());
+        EXPECT_EQ(x[11], 11.0f);
+        EXPECT_EQ(x[12], 1.0f);
+
+        EXPECT_THROW(S->reshape({16}), Exception);
+        EXPECT_THROW(X->reshape({5, 5}), Exception);
+        EXPECT_THROW(X->slice(2, 2, 5), Exception);
+        EXPECT_THROW(X->transpose({0, 0, 1}), Exception);
+        EXPECT_THROW(X->view({4, 8}, {8, 1}), Exception);
+    }
+
+    TEST(TensorView, CopiesNonContiguousViews)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        auto X = make_ref<TensorObj>(Shape{2, 3, 4}, DataType(INFINI_DTYPE_F32));
+        X->dataMalloc(runtime);
+        vector<float> x(24);
+        std::iota(x.begin(), x.end(), 0.0f);
+        X->copyFromHost(runtime, x.data());
+
+        // Rows 1 and 2 of every batch
+        auto S = X->slice(1, 1, 3);
+        vector<float> s(S->getElement());
+        S->copyToHost(runtime, s.data());
+        EXPECT_EQ(s, (vector<float>{4, 5, 6, 7, 8, 9, 10, 11,
+                                    16, 17, 18, 19, 20, 21, 22, 23}));
+        // T[b][j][i] = X[b][i][j]
+        auto T = X->transpose({0, 2, 1});
+        vector<float> t(T->getElement());
+        T->copyToHost(runtime, t.data());
+        for (size_t b = 0; b < 2; ++b)
+            for (size_t j = 0; j < 4; ++j)
+                for (size_t i = 0; i < 3; ++i)
+                    EXPECT_EQ(t[(b * 4 + j) * 3 + i], x[(b * 3 + i) * 4 + j]);
+
+        // Writes land on the view's elements only
+        vector<float> minus(S->getElement(), -1.0f);
+        S->copyFromHost(runtime, minus.data());
+        X->copyToHost(runtime, x.data());
+        for (size_t i = 0; i < 24; ++i)
+            EXPECT_EQ(x[i], (i % 12) < 4 ? float(i) : -1.0f) << i;
+        std::iota(t.begin(), t.end(), 100.0f);
+        T->copyFromHost(runtime, t.data());
+        X->copyToHost(runtime, x.data());
+        EXPECT_EQ(x[1], 103.0f);  // T[0][1][0]
+        EXPECT_EQ(x[4], 101.0f);  // T[0][0][1]
+        EXPECT_EQ(x[23], 123.0f); // T[1][3][2]
+
+        EXPECT_THROW(S->copyToHostAsync(runtime, s.data()), Exception);
+        EXPECT_THROW(T->copyFromHostAsync(runtime, t.data()), Exception);
+    }
+
+} // namespace infini
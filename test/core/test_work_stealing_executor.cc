@@ -0,0 +1,162 @@
+#include "core/work_stealing_executor.h"
+#include "operators/RMSNorm.h"
+#include "gtest/gtest.h"
+#include "test_ops.h"
+
+REGISTER_KERNEL(INFINI_DEVICE_CPU, OpType::Unknown, DelayKernel, "DelayKernel_CPU");
+
+namespace infini
+{
+    TEST(WorkStealingExecutor, RunsWideFrontierConcurrently)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({1}, DataType(INFINI_DTYPE_F32));
+        // Eight independent chains of two ops, reduced pairwise
+        TensorVec level;
+        for (int i = 0; i < 8; ++i)
+        {
+            auto t = g->addOp<UnknownObj>(TensorVec{X}, nullptr)->getOutput(0);
+            level.push_back(g->addOp<UnknownObj>(TensorVec{t}, nullptr)->getOutput(0));
+        }
+        while (level.size() > 1)
+        {
+            TensorVec next;
+            for (size_t i = 0; i < level.size(); i += 2)
+                next.push_back(g->addOp<UnknownObj>(TensorVec{level[i], level[i + 1]},
+                                                  nullptr)
+                                   ->getOutput(0));
+            level = next;
+        }
+        auto Y = level[0];
+        g->dataMalloc();
+        float x = 1.0f;
+        X->copyFromHost(runtime, &x);
+
+        WorkStealingExecutor::Config config;
+        config.numThreads = 8;
+        WorkStealingExecutor executor(runtime, config);
+        delaySpans.spans.clear();
+        executor.run(g);
+        float y = 0.0f;
+        Y->copyToHost(runtime, &y);
+        // Each chain gives x + 2, each of the three reduction levels adds 1
+        float expected = x + 2;
+        for (int i = 0; i < 3; ++i)
+            expected = 2 * expected + 1;
+        EXPECT_FLOAT_EQ(y, expected);
+
+        // Every op ran once and only after all of its predecessors finished
+        const auto &ops = g->getOperators();
+        ASSERT_EQ(delaySpans.spans.size(), ops.size());
+        for (auto &op : ops)
+        {
+            auto start = delaySpans.spans.at(op.get()).first;
+            for (auto &pred : op->getPredecessors())
+                EXPECT_GT(start, delaySpans.spans.at(pred.get()).second);
+        }
+        // and ops of different chains ran at the same time
+        bool overlapped = false;
+        for (size_t i = 0; i < 16; ++i)
+            for (size_t j = i + 1; j < 16; ++j)
+            {
+                auto [start1, end1] = delaySpans.spans.at(ops[i].get());
+                auto [start2, end2] = delaySpans.spans.at(ops[j].get());
+                overlapped |= i / 2 != j / 2 && start1 < end2 && start2 < end1;
+            }
+        EXPECT_TRUE(overlapped);
+        const auto &stats = executor.getStats();
+        EXPECT_LE(stats.criticalPathMs, stats.totalOpMs);
+    }
+
+    TEST(WorkStealingExecutor, PinsWorkersToCpus)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({1}, DataType(INFINI_DTYPE_F32));
+        auto a = g->addOp<UnknownObj>(X, nullptr)->getOutput(0);
+        auto b = g->addOp<UnknownObj>(X, nullptr)->getOutput(0);
+        auto Y = g->addOp<UnknownObj>(TensorVec{a, b}, nullptr)->getOutput(0);
+        g->dataMalloc();
+        float x = 1.0f, y = 0.0f;
+        X->copyFromHost(runtime, &x);
+
+        // Both workers share CPU 0, which every machine has
+        WorkStealingExecutor::Config config;
+        config.numThreads = 2;
+        config.cpus = {0};
+        WorkStealingExecutor executor(runtime, config);
+        executor.run(g);
+        Y->copyToHost(runtime, &y);
+        EXPECT_FLOAT_EQ(y, 2 * (x + 1) + 1);
+
+        config.cpus = {-1};
+        EXPECT_THROW(WorkStealingExecutor(runtime, config), Exception);
+#ifdef __linux__
+        // A valid id without a CPU behind it fails in the worker
+        config.cpus = {CPU_SETSIZE - 1};
+        EXPECT_THROW(WorkStealingExecutor(runtime, config), Exception);
+#endif
+    }
+
+    TEST(WorkStealingExecutor, InplaceWaitsForConcurrentReaders)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        auto W = g->addTensor({8}, dtype);
+        auto X = g->addTensor({4, 8}, dtype);
+        auto h = g->addOp<RMSNormObj>(X, nullptr, W)->getOutput(0);
+        // Nothing orders the two readers of h, so neither may overwrite it
+        auto z = g->addOp<RMSNormObj>(h, nullptr, W)->getOutput(0);
+        auto r = g->addOp<RMSNormObj>(h, nullptr, W)->getOutput(0);
+        g->addOp<RMSNormObj>(r, nullptr, W);
+        g->addOp<RMSNormObj>(z, nullptr, W);
+        g->dataMalloc();
+        EXPECT_EQ(g->getMemoryPlan().getOffset(r), g->getMemoryPlan().getOffset(h));
+
+        vector<float> ones(32, 1.0f);
+        W->copyFromHost(runtime, ones.data());
+        X->copyFromHost(runtime, ones.data());
+        WorkStealingExecutor::Config config;
+        config.numThreads = 2;
+        WorkStealingExecutor executor(runtime, config);
+        executor.run(g);
+        const auto &plan = g->getMemoryPlan();
+        EXPECT_NE(plan.getOffset(r), plan.getOffset(h));
+        EXPECT_NE(plan.getOffset(z), plan.getOffset(h));
+    }
+
+    TEST(WorkStealingExecutor, SerialRunStillAvailable)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        Tensor x = g->addTensor({1}, DataType(INFINI_DTYPE_F32));
+        auto X = x;
+        for (int i = 0; i < 3; ++i)
+            x = g->addOp<UnknownObj>(TensorVec{x}, nullptr)->getOutput(0);
+        g->dataMalloc();
+        float in = 0.0f, out = 0.0f;
+        X->copyFromHost(runtime, &in);
+
+        WorkStealingExecutor::Config config;
+        config.numThreads = 2;
+        WorkStealingExecutor executor(runtime, config);
+        // The executor is chosen per run
+        executor.run(g);
+        x->copyToHost(runtime, &out);
+        EXPECT_FLOAT_EQ(out, 3.0f);
+        runtime->run(g);
+        x->copyToHost(runtime, &out);
+        EXPECT_FLOAT_EQ(out, 3.0f);
+    }
+
+} // namespace infini
@@ -0,0 +1,27 @@
+#include "core/runtime.h"
+#include "operators/Activation.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    TEST(Activation, ReluAndClip)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({2, 3}, DataType(INFINI_DTYPE_F32));
+        auto R = g->addOp<ReluObj>(X, nullptr)->getOutput(0);
+        auto Y = g->addOp<ClipObj>(X, nullptr, -1.0f, 2.0f)->getOutput(0);
+        g->dataMalloc();
+        vector<float> x{-3.0f, -0.5f, 0.0f, 1.5f, 2.5f, 4.0f}, r(6), y(6);
+        X->copyFromHost(runtime, x.data());
+        runtime->prepare(g);
+        runtime->run(g);
+        R->copyToHost(runtime, r.data());
+        Y->copyToHost(runtime, y.data());
+        EXPECT_EQ(r, (vector<float>{0.0f, 0.0f, 0.0f, 1.5f, 2.5f, 4.0f}));
+        EXPECT_EQ(y, (vector<float>{-1.0f, -0.5f, 0.0f, 1.5f, 2.0f, 2.0f}));
+    }
+
+} // namespace infini
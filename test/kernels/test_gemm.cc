@@ -19,13 +19,12 @@ namespace infini
         auto op = g->addOp<GemmObj>(A, B, nullptr, nullptr, alpha, beta, transA, transB);
         g->dataMalloc();
         auto res = g->toString();
-        // Only when the data is contiguous, will this assignment be successful.
         std::vector<float> inputAData(A->getElement());
         std::iota(inputAData.begin(), inputAData.end(), 1);
         std::vector<float> inputBData(B->getElement());
         std::iota(inputBData.begin(), inputBData.end(), 1);
-        A->setData(inputAData.data());
-        B->setData(inputBData.data());
+        A->copyFromHost(runtime, inputAData.data());
+        B->copyFromHost(runtime, inputBData.data());
         std::cout << res << std::endl;
         runtime->run(g);
         auto output = op->getOutput(0);
@@ -38,4 +37,121 @@ namespace infini
         runGemmTest("NVIDIA", INFINI_DEVICE_NVIDIA, Shape{3, 5}, Shape{5, 2}, 1.0, 0.0, false, false, DataType(INFINI_DTYPE_F32));
     }
 
+    TEST(Gemm, BiasAndActivationEpilogue)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        DataType dtype(INFINI_DTYPE_F32);
+        size_t m = 3, k = 5, n = 4;
+        auto A = g->addTensor({m, k}, dtype);
+        auto B = g->addTensor({k, n}, dtype);
+        auto C = g->addTensor({n}, dtype); // one bias per column
+        auto op = g->addOp<GemmObj>(A, B, nullptr, C, 0.5f, 2.0f);
+        op->setActivation({ActType::Clip, -4.0f, 6.0f});
+        auto Y = op->getOutput(0);
+        g->dataMalloc();
+        vector<float> a(m * k), b(k * n), c{-3.0f, -1.0f, 1.0f, 3.0f}, y(m * n);
+        std::iota(a.begin(), a.end(), -7.0f);
+        for (size_t i = 0; i < b.size(); ++i)
+            b[i] = float(i % 3) - 1.0f;
+        A->copyFromHost(runtime, a.data());
+        B->copyFromHost(runtime, b.data());
+        C->copyFromHost(runtime, c.data());
+
+        vector<float> expected(m * n);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                float acc = 0;
+                for (size_t p = 0; p < k; ++p)
+                    acc += a[i * k + p] * b[p * n + j];
+                expected[i * n + j] = std::min(std::max(0.5f * acc + 2.0f * c[j], -4.0f), 6.0f);
+            }
+
+        for (auto &item : KernelRegistry::getInstance().getKernelItems(
+                 KernelAttrs{INFINI_DEVICE_CPU, OpType::Gemm}))
+        {
+            auto kernel = std::get<0>(item);
+            ASSERT_TRUE(kernel->isApplicable(op));
+            // The bias is applied on every run, not accumulated
+            for (int run = 0; run < 2; ++run)
+            {
+                kernel->compute(op, runtime.get());
+                Y->copyToHost(runtime, y.data());
+                EXPECT_EQ(y, expected) << std::get<1>(item) << " run " << run;
+            }
+        }
+    }
+
+    TEST(Gemm, TransposedOperands)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        DataType dtype(INFINI_DTYPE_F32);
+        size_t m = 3, k = 5, n = 4;
+        // Row-major m x k and k x n data, stored transposed where requested
+        vector<float> a(m * k), b(k * n);
+        std::iota(a.begin(), a.end(), -7.0f);
+        for (size_t i = 0; i < b.size(); ++i)
+            b[i] = float(i % 3) - 1.0f;
+        vector<float> expected(m * n, 0.0f);
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+                for (size_t p = 0; p < k; ++p)
+                    expected[i * n + j] += a[i * k + p] * b[p * n + j];
+        auto transposed = [](const vector<float> &data, size_t rows, size_t cols)
+        {
+            vector<float> ret(data.size());
+            for (size_t i = 0; i < rows; ++i)
+                for (size_t j = 0; j < cols; ++j)
+                    ret[j * rows + i] = data[i * cols + j];
+            return ret;
+        };
+
+        for (bool transA : {false, true})
+            for (bool transB : {false, true})
+            {
+                Graph g = make_ref<GraphObj>(runtime);
+                auto A = g->addTensor(transA ? Shape{k, m} : Shape{m, k}, dtype);
+                auto B = g->addTensor(transB ? Shape{n, k} : Shape{k, n}, dtype);
+                auto op = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f, transA,
+                                            transB);
+                auto Y = op->getOutput(0);
+                EXPECT_EQ(Y->getShape(), (Shape{m, n}));
+                g->dataMalloc();
+                A->copyFromHost(runtime, (transA ? transposed(a, m, k) : a).data());
+                B->copyFromHost(runtime, (transB ? transposed(b, k, n) : b).data());
+                for (auto &item : KernelRegistry::getInstance().getKernelItems(
+                         KernelAttrs{INFINI_DEVICE_CPU, OpType::Gemm}))
+                {
+                    auto kernel = std::get<0>(item);
+                    ASSERT_TRUE(kernel->isApplicable(op));
+                    kernel->compute(op, runtime.get());
+                    vector<float> y(m * n);
+                    Y->copyToHost(runtime, y.data());
+                    EXPECT_EQ(y, expected)
+                        << std::get<1>(item) << " transA=" << transA << " transB=" << transB;
+                }
+            }
+
+        // A transposed view is read in place, without a copy
+        auto storedB = make_ref<TensorObj>(Shape{n, k}, dtype);
+        storedB->dataMalloc(runtime);
+        storedB->copyFromHost(runtime, transposed(b, k, n).data());
+        Graph g = make_ref<GraphObj>(runtime);
+        auto A = g->addTensor({m, k}, dtype);
+        auto B = g->addTensor(storedB->transpose({1, 0}));
+        auto Y = g->addOp<GemmObj>(A, B, nullptr, nullptr, 1.0f, 0.0f)->getOutput(0);
+        g->dataMalloc();
+        EXPECT_EQ(B->getRawDataPtr<void *>(), storedB->getRawDataPtr<void *>());
+        A->copyFromHost(runtime, a.data());
+        runtime->run(g);
+        vector<float> y(m * n);
+        Y->copyToHost(runtime, y.data());
+        EXPECT_EQ(y, expected);
+    }
+
 } // namespace infini
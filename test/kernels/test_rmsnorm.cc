@@ -21,13 +21,12 @@ namespace infini
         auto op = g->addOp<RMSNormObj>(X, Y, W);
         g->dataMalloc();
         auto res = g->toString();
-        // Only when the data is contiguous, will this assignment be successful.
         std::vector<float> inputXData(X->getElement());
         std::iota(inputXData.begin(), inputXData.end(), 1);
         std::vector<float> inputWData(W->getElement());
         std::iota(inputWData.begin(), inputWData.end(), 1);
-        X->setData(inputXData.data());
-        W->setData(inputWData.data());
+        X->copyFromHost(runtime, inputXData.data());
+        W->copyFromHost(runtime, inputWData.data());
         std::for_each(inputXData.begin(), inputXData.end(), [](float val) {
             std::cout << val << ' ';
         });
@@ -0,0 +1,34 @@
+#include "core/runtime.h"
+#include "operators/Transpose.h"
+#include "gtest/gtest.h"
+
+namespace infini
+{
+    TEST(Transpose, Kernel)
+    {
+        Runtime &runtime = RuntimeObj::getInstance();
+        RuntimeObj::init();
+        runtime->initThreadContext(INFINI_DEVICE_CPU, 0);
+        Graph g = make_ref<GraphObj>(runtime);
+        auto X = g->addTensor({2, 3, 4}, DataType(INFINI_DTYPE_F32));
+        auto op = g->addOp<TransposeObj>(X, nullptr, vector<int>{2, 0, 1});
+        auto Y = op->getOutput(0);
+        EXPECT_EQ(Y->getShape(), (Shape{4, 2, 3}));
+        EXPECT_TRUE(Y->isContiguous());
+        EXPECT_FALSE(op->swapsLastTwoDims());
+        g->dataMalloc();
+        vector<float> x(24), y(24);
+        std::iota(x.begin(), x.end(), 0.0f);
+        X->copyFromHost(runtime, x.data());
+        runtime->prepare(g);
+        runtime->run(g);
+        Y->copyToHost(runtime, y.data());
+        for (size_t i = 0; i < 4; ++i)
+            for (size_t j = 0; j < 2; ++j)
+                for (size_t l = 0; l < 3; ++l)
+                    EXPECT_EQ(y[(i * 2 + j) * 3 + l], x[(j * 3 + l) * 4 + i]);
+
+        EXPECT_THROW(g->addOp<TransposeObj>(X, nullptr, vector<int>{0, 1}), Exception);
+    }
+
+} // namespace infini